@@ -10,6 +10,7 @@
 #include "unity.h"
 #include "utest.h"
 
+#include "sim5320_CellularNetwork.h"
 #include "sim5320_driver.h"
 #include "sim5320_tests_utils.h"
 
@@ -45,6 +46,17 @@ void test_software_reset()
     TEST_ASSERT_EQUAL(0, err);
 }
 
+void test_software_reset_fast_boot()
+{
+    modem->set_fast_boot(true);
+    int err = modem->reset(SIM5320::RESET_MODE_SOFT);
+    modem->set_fast_boot(false);
+    TEST_ASSERT_EQUAL(0, err);
+    // check that AT interface works
+    err = modem->init();
+    TEST_ASSERT_EQUAL(0, err);
+}
+
 void test_hardware_reset()
 {
     if (MBED_CONF_SIM5320_DRIVER_TEST_RESET_PIN != NC) {
@@ -122,10 +134,68 @@ void test_cellular_info_serial_number_imei()
     TEST_ASSERT(not_empty(buf));
 }
 
+void test_urc_dispatcher()
+{
+    const size_t buf_size = 128;
+    char buf[buf_size];
+    buf[0] = '\0';
+    int err;
+
+    err = modem->start_urc_dispatcher();
+    TEST_ASSERT_EQUAL(0, err);
+    // check that AT commands work with dispatcher
+    err = modem->get_information()->get_manufacturer(buf, buf_size);
+    TEST_ASSERT_EQUAL(0, err);
+    TEST_ASSERT(has_substring(buf, "SIMCOM"));
+    // check that dispatcher cannot be started twice
+    err = modem->start_urc_dispatcher();
+    TEST_ASSERT_NOT_EQUAL(0, err);
+    err = modem->stop_urc_dispatcher();
+    TEST_ASSERT_EQUAL(0, err);
+}
+
+void test_settings_cache()
+{
+    SIM5320CellularDevice *device = static_cast<SIM5320CellularDevice *>(modem->get_device());
+    SIM5320SettingsCache *settings_cache = modem->get_settings_cache();
+    int err;
+
+    // write setting and check that cache has it
+    SIM5320CellularNetwork *network = static_cast<SIM5320CellularNetwork *>(modem->get_network());
+    err = network->set_preffered_radio_access_technology_mode(SIM5320CellularNetwork::PRATM_AUTOMATIC);
+    TEST_ASSERT_EQUAL(0, err);
+    TEST_ASSERT_TRUE(settings_cache->is_set(SIM5320SettingsCache::CNMP, 2));
+    // cached values should match device ones
+    err = device->verify_settings_cache();
+    TEST_ASSERT_EQUAL(0, err);
+    TEST_ASSERT_TRUE(settings_cache->is_set(SIM5320SettingsCache::CNMP, 2));
+    // check cache cleanup after reset
+    err = modem->reset(SIM5320::RESET_MODE_SOFT);
+    TEST_ASSERT_EQUAL(0, err);
+    TEST_ASSERT_FALSE(settings_cache->is_set(SIM5320SettingsCache::CNMP, 2));
+}
+
+void test_state_cache()
+{
+    bool active = false;
+    bool actual_active = false;
+    int err;
+
+    // cached state should match device one
+    err = modem->is_active(active);
+    TEST_ASSERT_EQUAL(0, err);
+    err = modem->is_active(actual_active, true);
+    TEST_ASSERT_EQUAL(0, err);
+    TEST_ASSERT_EQUAL(actual_active, active);
+    // note: SIM5320::init switches device into minimal functionality mode
+    TEST_ASSERT_FALSE(active);
+}
+
 // test cases description
 #define SIM5320Case(test_fun) Case(#test_fun, case_setup_handler, test_fun, greentea_case_teardown_handler, greentea_case_failure_continue_handler)
 static Case cases[] = {
     SIM5320Case(test_software_reset),
+    SIM5320Case(test_software_reset_fast_boot),
     SIM5320Case(test_hardware_reset),
     SIM5320Case(test_init_state),
     SIM5320Case(test_cellular_info_manufacturer),
@@ -133,6 +203,9 @@ static Case cases[] = {
     SIM5320Case(test_cellular_info_revision),
     SIM5320Case(test_cellular_info_serial_number_sn),
     SIM5320Case(test_cellular_info_serial_number_imei),
+    SIM5320Case(test_urc_dispatcher),
+    SIM5320Case(test_settings_cache),
+    SIM5320Case(test_state_cache),
 };
 static Specification specification(test_setup_handler, cases, test_teardown_handler);
 
@@ -0,0 +1,162 @@
+/**
+ * Test of the file system that is stored in the modem storage.
+ *
+ * It doesn't require any SIM card.
+ */
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "mbed.h"
+
+#include "greentea-client/test_env.h"
+#include "unity.h"
+#include "utest.h"
+
+#include "sim5320_FileSystem.h"
+#include "sim5320_driver.h"
+#include "sim5320_tests_utils.h"
+#include "sim5320_utils.h"
+
+using namespace utest::v1;
+using namespace sim5320;
+
+static sim5320::SIM5320 *modem;
+static sim5320::SIM5320FileSystem *modem_fs;
+
+static utest::v1::status_t test_setup_handler(const size_t number_of_cases)
+{
+    modem = new SIM5320(MBED_CONF_SIM5320_DRIVER_TEST_UART_TX, MBED_CONF_SIM5320_DRIVER_TEST_UART_RX, NC, NC, MBED_CONF_SIM5320_DRIVER_TEST_RESET_PIN);
+    modem->init();
+    int err = 0;
+    err = any_error(err, modem->reset());
+    err = any_error(err, modem->init());
+    SIM5320CellularDevice *device = static_cast<SIM5320CellularDevice *>(modem->get_device());
+    modem_fs = new SIM5320FileSystem(*device->get_at_handler(), "modem");
+    err = any_error(err, modem_fs->mount(nullptr));
+    return unite_utest_status_with_err(greentea_test_setup_handler(number_of_cases), err);
+}
+
+static void test_teardown_handler(const size_t passed, const size_t failed, const failure_t failure)
+{
+    modem_fs->unmount();
+    delete modem_fs;
+    delete modem;
+    return greentea_test_teardown_handler(passed, failed, failure);
+}
+
+void test_file_write_read()
+{
+    char buf[64];
+    const char *test_data = "modem file system test data";
+    size_t test_data_len = strlen(test_data);
+
+    // write file by small chunks
+    FILE *f = fopen("/modem/fs_test.txt", "w");
+    TEST_ASSERT_NOT_NULL(f);
+    for (size_t i = 0; i < test_data_len; i++) {
+        TEST_ASSERT_EQUAL(test_data[i], fputc(test_data[i], f));
+    }
+    TEST_ASSERT_EQUAL(0, fclose(f));
+
+    // read file back
+    f = fopen("/modem/fs_test.txt", "r");
+    TEST_ASSERT_NOT_NULL(f);
+    size_t read_len = fread(buf, 1, sizeof(buf) - 1, f);
+    buf[read_len] = '\0';
+    TEST_ASSERT_EQUAL(0, fclose(f));
+    TEST_ASSERT_EQUAL_STRING(test_data, buf);
+
+    // append data
+    f = fopen("/modem/fs_test.txt", "a");
+    TEST_ASSERT_NOT_NULL(f);
+    TEST_ASSERT_EQUAL(3, fwrite("123", 1, 3, f));
+    TEST_ASSERT_EQUAL(0, fclose(f));
+
+    struct stat st;
+    TEST_ASSERT_EQUAL(0, stat("/modem/fs_test.txt", &st));
+    TEST_ASSERT_TRUE(S_ISREG(st.st_mode));
+    TEST_ASSERT_EQUAL(test_data_len + 3, st.st_size);
+
+    TEST_ASSERT_EQUAL(0, remove("/modem/fs_test.txt"));
+    TEST_ASSERT_NOT_EQUAL(0, stat("/modem/fs_test.txt", &st));
+}
+
+void test_file_truncate_to_empty()
+{
+    struct stat st;
+
+    FILE *f = fopen("/modem/fs_test_empty.txt", "w");
+    TEST_ASSERT_NOT_NULL(f);
+    fputs("abc", f);
+    TEST_ASSERT_EQUAL(0, fclose(f));
+    TEST_ASSERT_EQUAL(0, stat("/modem/fs_test_empty.txt", &st));
+    TEST_ASSERT_EQUAL(3, st.st_size);
+
+    // the device cannot store empty files, so truncated file must be deleted
+    f = fopen("/modem/fs_test_empty.txt", "w");
+    TEST_ASSERT_NOT_NULL(f);
+    TEST_ASSERT_EQUAL(0, fclose(f));
+    TEST_ASSERT_NOT_EQUAL(0, stat("/modem/fs_test_empty.txt", &st));
+}
+
+void test_dirs()
+{
+    struct stat st;
+    struct dirent *ent;
+    bool file_found = false;
+
+    TEST_ASSERT_EQUAL(0, mkdir("/modem/fs_test_dir", 0777));
+    TEST_ASSERT_EQUAL(0, stat("/modem/fs_test_dir", &st));
+    TEST_ASSERT_TRUE(S_ISDIR(st.st_mode));
+
+    FILE *f = fopen("/modem/fs_test_dir/file.txt", "w");
+    TEST_ASSERT_NOT_NULL(f);
+    fputs("abc", f);
+    TEST_ASSERT_EQUAL(0, fclose(f));
+
+    DIR *dir = opendir("/modem/fs_test_dir");
+    TEST_ASSERT_NOT_NULL(dir);
+    while ((ent = readdir(dir)) != nullptr) {
+        if (strcmp(ent->d_name, "file.txt") == 0) {
+            TEST_ASSERT_EQUAL(DT_REG, ent->d_type);
+            file_found = true;
+        }
+    }
+    TEST_ASSERT_EQUAL(0, closedir(dir));
+    TEST_ASSERT_TRUE(file_found);
+
+    TEST_ASSERT_EQUAL(0, rename("/modem/fs_test_dir/file.txt", "/modem/fs_test_dir/file2.txt"));
+    TEST_ASSERT_EQUAL(0, remove("/modem/fs_test_dir/file2.txt"));
+    TEST_ASSERT_EQUAL(0, remove("/modem/fs_test_dir"));
+}
+
+void test_statvfs()
+{
+    struct statvfs buf;
+    TEST_ASSERT_EQUAL(0, statvfs("/modem/", &buf));
+    TEST_ASSERT_NOT_EQUAL(0, buf.f_blocks);
+}
+
+// test cases description
+#define SIM5320Case(test_fun) Case(#test_fun, test_fun, greentea_case_failure_continue_handler)
+static Case cases[] = {
+    SIM5320Case(test_file_write_read),
+    SIM5320Case(test_file_truncate_to_empty),
+    SIM5320Case(test_dirs),
+    SIM5320Case(test_statvfs),
+};
+static Specification specification(test_setup_handler, cases, test_teardown_handler);
+
+// Entry point into the tests
+int main()
+{
+    // base config validation
+    validate_test_pins(true, true, false);
+
+    // host handshake
+    // note: should be invoked here or in the test_setup_handler
+    GREENTEA_SETUP(200, "default_auto");
+    // run tests
+    return !Harness::run(specification);
+}
@@ -201,6 +201,51 @@ void test_listdir()
     TEST_ASSERT_NOT_EQUAL(0, err);
 }
 
+struct listdir_counter_t {
+    int file_count = 0;
+    int dir_count = 0;
+    bool has_some_file = false;
+    long some_file_size = -1;
+
+    void count(const SIM5320FTPClient::dir_entry_view &entry)
+    {
+        if (entry.d_type == DT_DIR) {
+            dir_count++;
+        } else {
+            file_count++;
+            if (strcmp(entry.name, "some file.txt") == 0) {
+                has_some_file = true;
+                some_file_size = entry.size;
+            }
+        }
+    }
+};
+
+void test_listdir_stream()
+{
+    int err;
+    char path_buf[128];
+
+    // create test files and directory
+    for (int i = 0; i < 3; i++) {
+        sprintf(path_buf, "%s/%s", test_dir, i == 0 ? "some file.txt" : i == 1 ? "f1.txt" : "f2.txt");
+        err = ftp_client->put(path_buf, (uint8_t *)"abc", 3);
+        TEST_ASSERT_EQUAL(0, err);
+    }
+    sprintf(path_buf, "%s/%s", test_dir, "some_dir");
+    err = ftp_client->mkdir(path_buf);
+    TEST_ASSERT_EQUAL(0, err);
+
+    // check listdir results
+    listdir_counter_t counter;
+    err = ftp_client->listdir(test_dir, callback(&counter, &listdir_counter_t::count));
+    TEST_ASSERT_EQUAL(0, err);
+    TEST_ASSERT_EQUAL(3, counter.file_count);
+    TEST_ASSERT_EQUAL(1, counter.dir_count);
+    TEST_ASSERT_TRUE(counter.has_some_file);
+    TEST_ASSERT_EQUAL(3, counter.some_file_size);
+}
+
 void test_rmfile()
 {
     int err;
@@ -459,15 +504,483 @@ void test_upload_download_file()
     }
 }
 
+void test_download_resume()
+{
+    int err;
+    int res;
+    int file;
+    char local_path[32];
+    char remote_path[96];
+    const size_t file_size = 2560;
+    const size_t local_part_size = 1000;
+    uint8_t *file_data = new uint8_t[file_size];
+    uint8_t sym;
+    sprintf(remote_path, "%s/%s", test_dir, "resume_file.txt");
+    sprintf(local_path, "/heap/%s", "resume_file.txt");
+    for (size_t i = 0; i < file_size; i++) {
+        file_data[i] = '0' + i % 10;
+    }
+
+    // 1. Upload test file
+    err = ftp_client->put(remote_path, file_data, file_size);
+    TEST_ASSERT_EQUAL(0, err);
+    // 2. Create partially downloaded local file
+    file = open(local_path, O_WRONLY | O_CREAT | O_TRUNC);
+    TEST_ASSERT_TRUE(file >= 0);
+    res = write(file, file_data, local_part_size);
+    TEST_ASSERT_EQUAL(local_part_size, res);
+    err = close(file);
+    TEST_ASSERT_EQUAL(0, err);
+    // 3. Download remaining file part
+    err = ftp_client->download_resume(remote_path, local_path);
+    TEST_ASSERT_EQUAL(0, err);
+    // 4. Validate local file
+    file = open(local_path, O_RDONLY);
+    TEST_ASSERT_TRUE(file >= 0);
+    size_t total_len = 0;
+    while ((res = read(file, &sym, 1)) == 1) {
+        if (total_len < file_size) {
+            TEST_ASSERT_EQUAL(file_data[total_len], sym);
+        }
+        total_len++;
+    }
+    TEST_ASSERT_EQUAL(file_size, total_len);
+    err = close(file);
+    TEST_ASSERT_EQUAL(0, err);
+
+    delete[] file_data;
+}
+
+static int write_test_file(const char *path, const char *content)
+{
+    int file = open(path, O_WRONLY | O_CREAT | O_TRUNC);
+    if (file < 0) {
+        return file;
+    }
+    ssize_t res = write(file, content, strlen(content));
+    int err = close(file);
+    return res == (ssize_t)strlen(content) ? err : -1;
+}
+
+void test_sync_dir()
+{
+    int err;
+    char remote_dir[96];
+    SIM5320FTPClient::sync_summary_t summary;
+    sprintf(remote_dir, "%s/%s", test_dir, "sync_dir");
+
+    // create local files
+    err = mkdir("/heap/sync_dir", 0777);
+    TEST_ASSERT_EQUAL(0, err);
+    err = write_test_file("/heap/sync_dir/log 1.txt", "abc");
+    TEST_ASSERT_EQUAL(0, err);
+    err = write_test_file("/heap/sync_dir/log_2.txt", "defg");
+    TEST_ASSERT_EQUAL(0, err);
+
+    // 1. Upload all files to new directory
+    err = ftp_client->sync_dir("/heap/sync_dir", remote_dir, SIM5320FTPClient::SYNC_POLICY_SIZE, &summary);
+    TEST_ASSERT_EQUAL(0, err);
+    TEST_ASSERT_EQUAL(2, summary.files_checked);
+    TEST_ASSERT_EQUAL(2, summary.files_uploaded);
+    TEST_ASSERT_EQUAL(7, (int)summary.bytes_uploaded);
+    // 2. Check that unchanged files are skipped
+    err = ftp_client->sync_dir("/heap/sync_dir", remote_dir, SIM5320FTPClient::SYNC_POLICY_SIZE, &summary);
+    TEST_ASSERT_EQUAL(0, err);
+    TEST_ASSERT_EQUAL(2, summary.files_checked);
+    TEST_ASSERT_EQUAL(0, summary.files_uploaded);
+    // 3. Check that only changed file is uploaded
+    err = write_test_file("/heap/sync_dir/log_2.txt", "defgh");
+    TEST_ASSERT_EQUAL(0, err);
+    err = ftp_client->sync_dir("/heap/sync_dir", remote_dir, SIM5320FTPClient::SYNC_POLICY_SIZE, &summary);
+    TEST_ASSERT_EQUAL(0, err);
+    TEST_ASSERT_EQUAL(1, summary.files_uploaded);
+    TEST_ASSERT_EQUAL(5, (int)summary.bytes_uploaded);
+}
+
+void test_upload_double_buffering()
+{
+    int err;
+    char remote_path[96];
+    const size_t file_size = 3000;
+    long remote_file_size = 0;
+    sprintf(remote_path, "%s/%s", test_dir, "double_buffer_file.txt");
+
+    struct data_generator_t {
+        size_t remaining;
+        ssize_t fetch(uint8_t *buf, size_t len)
+        {
+            size_t block_size = len < remaining ? len : remaining;
+            memset(buf, 'd', block_size);
+            remaining -= block_size;
+            return block_size;
+        }
+    } data_generator = { file_size };
+
+    err = ftp_client->set_double_buffering(true);
+    TEST_ASSERT_EQUAL(0, err);
+    err = ftp_client->put(remote_path, callback(&data_generator, &data_generator_t::fetch));
+    ftp_client->set_double_buffering(false);
+    TEST_ASSERT_EQUAL(0, err);
+
+    err = ftp_client->get_file_size(remote_path, remote_file_size);
+    TEST_ASSERT_EQUAL(0, err);
+    TEST_ASSERT_EQUAL(file_size, remote_file_size);
+}
+
+void test_upload_cooperative_mode()
+{
+    int err;
+    char remote_path[96];
+    const size_t file_size = 4096;
+    long remote_file_size = 0;
+    uint8_t *file_data = new uint8_t[file_size];
+    const size_t info_buf_size = 64;
+    char info_buf[info_buf_size];
+    int info_err = -1;
+    sprintf(remote_path, "%s/%s", test_dir, "cooperative_file.txt");
+    memset(file_data, 'c', file_size);
+
+    // run upload in a separate thread and check that other functions work meanwhile
+    struct uploader_t {
+        SIM5320FTPClient *ftp_client;
+        const char *path;
+        uint8_t *data;
+        size_t size;
+        int err;
+        void run()
+        {
+            err = ftp_client->put(path, data, size);
+        }
+    } uploader = { ftp_client, remote_path, file_data, file_size, -1 };
+    Thread upload_thread(osPriorityNormal, 4096);
+
+    ftp_client->set_cooperative_mode(true);
+    upload_thread.start(callback(&uploader, &uploader_t::run));
+    ThisThread::sleep_for(100ms);
+    info_err = modem->get_information()->get_manufacturer(info_buf, info_buf_size);
+    upload_thread.join();
+    ftp_client->set_cooperative_mode(false);
+
+    TEST_ASSERT_EQUAL(0, info_err);
+    TEST_ASSERT_EQUAL(0, uploader.err);
+    err = ftp_client->get_file_size(remote_path, remote_file_size);
+    TEST_ASSERT_EQUAL(0, err);
+    TEST_ASSERT_EQUAL(file_size, remote_file_size);
+
+    delete[] file_data;
+}
+
+struct progress_counter_t {
+    int calls = 0;
+    uint32_t last_bytes_done = 0;
+
+    void on_progress(const SIM5320FTPClient::transfer_stats_t &stats)
+    {
+        calls++;
+        last_bytes_done = stats.bytes_done;
+    }
+};
+
+static ssize_t skip_data(uint8_t *data, size_t size)
+{
+    return size;
+}
+
+void test_transfer_progress()
+{
+    int err;
+    char remote_path[96];
+    const size_t file_size = 3000;
+    uint8_t *file_data = new uint8_t[file_size];
+    progress_counter_t progress_counter;
+    SIM5320FTPClient::transfer_stats_t stats;
+    sprintf(remote_path, "%s/%s", test_dir, "progress_file.txt");
+    memset(file_data, 'p', file_size);
+
+    ftp_client->set_progress_callback(callback(&progress_counter, &progress_counter_t::on_progress));
+    // check upload statistics
+    err = ftp_client->put(remote_path, file_data, file_size);
+    TEST_ASSERT_EQUAL(0, err);
+    ftp_client->get_transfer_stats(stats);
+    TEST_ASSERT_EQUAL(file_size, stats.bytes_done);
+    TEST_ASSERT_TRUE(progress_counter.calls > 0);
+    TEST_ASSERT_EQUAL(file_size, progress_counter.last_bytes_done);
+    // check download statistics
+    err = ftp_client->get(remote_path, callback(skip_data));
+    TEST_ASSERT_EQUAL(0, err);
+    ftp_client->get_transfer_stats(stats);
+    TEST_ASSERT_EQUAL(file_size, stats.bytes_done);
+    TEST_ASSERT_EQUAL(file_size, progress_counter.last_bytes_done);
+    ftp_client->set_progress_callback(nullptr);
+
+    delete[] file_data;
+}
+
+struct pending_tracker_t {
+    uint32_t max_pending = 0;
+
+    void on_progress(const SIM5320FTPClient::transfer_stats_t &stats)
+    {
+        if (stats.modem_pending > max_pending) {
+            max_pending = stats.modem_pending;
+        }
+    }
+};
+
+void test_upload_overestimated_bandwidth()
+{
+    int err;
+    char remote_path[96];
+    const size_t file_size = 32768;
+    const uint32_t fake_bandwidth = 10000000;
+    // device upload buffer limit that is used by driver
+    const uint32_t max_unsent_data = 6144;
+    uint8_t *file_data = new uint8_t[file_size];
+    pending_tracker_t pending_tracker;
+    sprintf(remote_path, "%s/%s", test_dir, "bandwidth_file.txt");
+    memset(file_data, 'b', file_size);
+
+    // stale estimation from previous transfer shouldn't overflow device buffer
+    ftp_client->set_upload_bandwidth(fake_bandwidth);
+    ftp_client->set_progress_callback(callback(&pending_tracker, &pending_tracker_t::on_progress));
+    err = ftp_client->put(remote_path, file_data, file_size);
+    ftp_client->set_progress_callback(nullptr);
+    TEST_ASSERT_EQUAL(0, err);
+    TEST_ASSERT_TRUE(pending_tracker.max_pending <= max_unsent_data);
+    // estimation should be corrected
+    TEST_ASSERT_TRUE(ftp_client->get_upload_bandwidth() < fake_bandwidth / 2);
+
+    delete[] file_data;
+}
+
+struct buffer_comparator_t {
+    const uint8_t *expected_data;
+    size_t expected_len;
+    size_t pos = 0;
+    bool equal = true;
+
+    buffer_comparator_t(const uint8_t *expected_data, size_t expected_len)
+        : expected_data(expected_data)
+        , expected_len(expected_len)
+    {
+    }
+
+    ssize_t compare(uint8_t *data, size_t size)
+    {
+        if (pos + size > expected_len || memcmp(expected_data + pos, data, size) != 0) {
+            equal = false;
+        }
+        pos += size;
+        return size;
+    }
+};
+
+void test_transfer_compression()
+{
+    int err;
+    char remote_path[96];
+    const size_t file_size = 4000;
+    long remote_file_size = 0;
+    uint8_t *file_data = new uint8_t[file_size];
+    sprintf(remote_path, "%s/%s", test_dir, "compressed_file.lz");
+    for (size_t i = 0; i < file_size; i++) {
+        file_data[i] = "log line: value=1\n"[i % 18];
+    }
+
+    err = ftp_client->set_compression(true);
+    TEST_ASSERT_EQUAL(0, err);
+    // upload compressed data
+    err = ftp_client->put(remote_path, file_data, file_size);
+    TEST_ASSERT_EQUAL(0, err);
+    err = ftp_client->get_file_size(remote_path, remote_file_size);
+    TEST_ASSERT_EQUAL(0, err);
+    TEST_ASSERT_TRUE(remote_file_size > 0 && remote_file_size < (long)file_size / 4);
+    // download and decompress data
+    buffer_comparator_t comparator(file_data, file_size);
+    err = ftp_client->get(remote_path, callback(&comparator, &buffer_comparator_t::compare));
+    TEST_ASSERT_EQUAL(0, err);
+    TEST_ASSERT_EQUAL(file_size, comparator.pos);
+    TEST_ASSERT_TRUE(comparator.equal);
+    err = ftp_client->set_compression(false);
+    TEST_ASSERT_EQUAL(0, err);
+
+    delete[] file_data;
+}
+
+void test_transfer_digest()
+{
+    int err;
+    char remote_path[96];
+    char local_path[32];
+    SIM5320FTPClient::digest_t digest;
+    SIM5320FTPClient::digest_t download_digest;
+    // CRC-32 check value
+    const uint8_t expected_crc[4] = { 0xCB, 0xF4, 0x39, 0x26 };
+    const uint8_t wrong_crc[4] = { 0x00, 0x00, 0x00, 0x00 };
+    sprintf(remote_path, "%s/%s", test_dir, "digest_file.txt");
+    sprintf(local_path, "/heap/%s", "digest_file.txt");
+
+    // 1. Upload file with CRC-32 check
+    err = write_test_file(local_path, "123456789");
+    TEST_ASSERT_EQUAL(0, err);
+    digest.type = SIM5320FTPClient::DIGEST_CRC32;
+    err = ftp_client->upload(local_path, remote_path, &digest, expected_crc);
+    TEST_ASSERT_EQUAL(0, err);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(expected_crc, digest.value, 4);
+    // 2. Download file with SHA-256 and compare it with upload one
+    digest.type = SIM5320FTPClient::DIGEST_SHA256;
+    err = ftp_client->upload(local_path, remote_path, &digest);
+    TEST_ASSERT_EQUAL(0, err);
+    download_digest.type = SIM5320FTPClient::DIGEST_SHA256;
+    err = ftp_client->download(remote_path, local_path, &download_digest, digest.value);
+    TEST_ASSERT_EQUAL(0, err);
+    // 3. Check mismatch detection
+    download_digest.type = SIM5320FTPClient::DIGEST_CRC32;
+    err = ftp_client->download(remote_path, local_path, &download_digest, wrong_crc);
+    TEST_ASSERT_EQUAL(MBED_ERROR_INVALID_DATA_DETECTED, err);
+}
+
+void test_job_queue()
+{
+    int err;
+    size_t num_failed = 0;
+    char dir_path[96];
+    char remote_path[96];
+    char missed_path[96];
+    const char *local_path = "/heap/job_file.txt";
+    SIM5320FTPClient::job_t jobs[4];
+    sprintf(dir_path, "%s/%s", test_dir, "job_dir");
+    sprintf(remote_path, "%s/%s", dir_path, "job_file.txt");
+    sprintf(missed_path, "%s/%s", dir_path, "missed_file.txt");
+    err = write_test_file(local_path, "job data");
+    TEST_ASSERT_EQUAL(0, err);
+
+    jobs[0].type = SIM5320FTPClient::JOB_MKDIR;
+    jobs[0].remote_path = dir_path;
+    jobs[1].type = SIM5320FTPClient::JOB_UPLOAD;
+    jobs[1].local_path = local_path;
+    jobs[1].remote_path = remote_path;
+    jobs[2].type = SIM5320FTPClient::JOB_RMFILE;
+    jobs[2].remote_path = missed_path;
+    jobs[3].type = SIM5320FTPClient::JOB_DOWNLOAD;
+    jobs[3].local_path = local_path;
+    jobs[3].remote_path = remote_path;
+    for (int i = 0; i < 4; i++) {
+        ftp_client->enqueue_job(&jobs[i]);
+    }
+
+    err = ftp_client->run_jobs(&num_failed);
+    TEST_ASSERT_NOT_EQUAL(0, err);
+    TEST_ASSERT_EQUAL(1, num_failed);
+    TEST_ASSERT_EQUAL(0, jobs[0].result);
+    TEST_ASSERT_EQUAL(0, jobs[1].result);
+    TEST_ASSERT_NOT_EQUAL(0, jobs[2].result);
+    TEST_ASSERT_EQUAL(0, jobs[3].result);
+    // check that queue is empty
+    err = ftp_client->run_jobs(&num_failed);
+    TEST_ASSERT_EQUAL(0, err);
+    TEST_ASSERT_EQUAL(0, num_failed);
+}
+
+void test_session_keep_alive()
+{
+    int err;
+    bool res;
+    EventQueue queue;
+    Thread queue_thread;
+    queue_thread.start(callback(&queue, &EventQueue::dispatch_forever));
+
+    ftp_client->set_auto_reconnect(true);
+    // queue is required
+    err = ftp_client->set_keep_alive(5s);
+    TEST_ASSERT_NOT_EQUAL(0, err);
+    err = ftp_client->set_keep_alive(5s, &queue);
+    TEST_ASSERT_EQUAL(0, err);
+    // wait longer than device FTP timeout and check that session is alive
+    ThisThread::sleep_for(30s);
+    TEST_ASSERT_FALSE(ftp_client->is_session_lost());
+    err = ftp_client->exists(test_dir, res);
+    TEST_ASSERT_EQUAL(0, err);
+    TEST_ASSERT_TRUE(res);
+    ftp_client->set_keep_alive(0ms);
+    ftp_client->set_auto_reconnect(false);
+
+    queue.break_dispatch();
+    queue_thread.join();
+}
+
+struct modem_file_reader_t {
+    char data[64];
+    size_t len;
+
+    ssize_t read(uint8_t *buf, size_t size)
+    {
+        if (size > sizeof(data) - 1 - len) {
+            size = sizeof(data) - 1 - len;
+        }
+        memcpy(data + len, buf, size);
+        len += size;
+        data[len] = '\0';
+        return size;
+    }
+};
+
+void test_modem_transfer()
+{
+    int err;
+    char remote_path[96];
+    const char *test_data = "modem file data";
+    modem_file_reader_t reader = {};
+    sprintf(remote_path, "%s/%s", test_dir, "modem_file.txt");
+    err = ftp_client->put(remote_path, (uint8_t *)test_data, strlen(test_data));
+    TEST_ASSERT_EQUAL(0, err);
+
+    // 1. Download file to modem storage
+    err = ftp_client->fetch_to_modem(remote_path);
+    TEST_ASSERT_EQUAL(0, err);
+    err = ftp_client->wait_modem_transfer(60s);
+    TEST_ASSERT_EQUAL(0, err);
+    err = ftp_client->read_modem_file("C:/modem_file.txt", callback(&reader, &modem_file_reader_t::read));
+    TEST_ASSERT_EQUAL(0, err);
+    TEST_ASSERT_EQUAL_STRING(test_data, reader.data);
+
+    // 2. Upload it back
+    err = ftp_client->rmfile(remote_path);
+    TEST_ASSERT_EQUAL(0, err);
+    err = ftp_client->push_from_modem(remote_path);
+    TEST_ASSERT_EQUAL(0, err);
+    err = ftp_client->wait_modem_transfer(60s);
+    TEST_ASSERT_EQUAL(0, err);
+    long size = -1;
+    err = ftp_client->get_file_size(remote_path, size);
+    TEST_ASSERT_EQUAL(0, err);
+    TEST_ASSERT_EQUAL(strlen(test_data), size);
+
+    err = ftp_client->delete_modem_file("C:/modem_file.txt");
+    TEST_ASSERT_EQUAL(0, err);
+}
+
 // test cases description
 #define SIM5320Case(test_fun) Case(#test_fun, case_setup_handler, test_fun, greentea_case_teardown_handler, greentea_case_failure_continue_handler)
 static Case cases[] = {
     SIM5320Case(test_listdir),
+    SIM5320Case(test_listdir_stream),
     SIM5320Case(test_rmfile),
     SIM5320Case(test_rmdir),
     SIM5320Case(test_rmtree),
     SIM5320Case(test_info_functions),
-    SIM5320Case(test_upload_download_file)
+    SIM5320Case(test_upload_download_file),
+    SIM5320Case(test_download_resume),
+    SIM5320Case(test_sync_dir),
+    SIM5320Case(test_upload_double_buffering),
+    SIM5320Case(test_upload_cooperative_mode),
+    SIM5320Case(test_transfer_progress),
+    SIM5320Case(test_upload_overestimated_bandwidth),
+    SIM5320Case(test_transfer_compression),
+    SIM5320Case(test_transfer_digest),
+    SIM5320Case(test_job_queue),
+    SIM5320Case(test_session_keep_alive),
+    SIM5320Case(test_modem_transfer)
 
 };
 static Specification specification(test_setup_handler, cases, test_teardown_handler);
@@ -63,6 +63,9 @@ static int coord_clear(SIM5320LocationService::coord_t &coord)
     coord.altitude = 0;
     coord.longitude = 0;
     coord.latitude = 0;
+    coord.time_ms = -1;
+    coord.speed = -1;
+    coord.course = -1;
     return 0;
 }
 
@@ -104,6 +107,10 @@ static int coord_verify(SIM5320LocationService::coord_t &coord, int line_no)
         UNITY_TEST_FAIL(line_no, "Expected that longitude is filled, but it isn't");
         err = -5;
     }
+    if (coord.time_ms < 0 || coord.time_ms >= 1000 || coord.speed < 0 || coord.course < 0 || coord.course >= 360) {
+        UNITY_TEST_FAIL(line_no, "Invalid speed, course or time value");
+        err = -6;
+    }
 
     return err;
 }
@@ -279,6 +286,178 @@ void test_apgs()
     modem->network_down();
 }
 
+void test_gps_stream()
+{
+    SIM5320LocationService::coord_t coord;
+    uint32_t first_fix_number = 0;
+    uint32_t fix_number = 0;
+    int err;
+
+    err = modem->start_urc_dispatcher();
+    TEST_ASSERT_EQUAL(0, err);
+    err = location_service->gps_start();
+    TEST_ASSERT_EQUAL(0, err);
+    err = location_service->gps_stream_start(1s);
+    TEST_ASSERT_EQUAL(0, err);
+
+    // wait first fix without AT commands
+    Timer tm;
+    tm.start();
+    while (!location_service->gps_stream_read(&coord, &first_fix_number) && tm.elapsed_time() < 120s) {
+        ThisThread::sleep_for(1s);
+    }
+    TEST_ASSERT_NOT_EQUAL(0, first_fix_number);
+    COORD_VERIFY(coord);
+    // check that positions are updated
+    ThisThread::sleep_for(5s);
+    TEST_ASSERT_TRUE(location_service->gps_stream_read(&coord, &fix_number));
+    TEST_ASSERT_TRUE(fix_number > first_fix_number);
+
+    err = location_service->gps_stream_stop();
+    TEST_ASSERT_EQUAL(0, err);
+    err = location_service->gps_stop();
+    TEST_ASSERT_EQUAL(0, err);
+    err = modem->stop_urc_dispatcher();
+    TEST_ASSERT_EQUAL(0, err);
+}
+
+void test_gps_signal_info()
+{
+    SIM5320LocationService::gps_signal_info_t info;
+    int err;
+
+    err = location_service->gps_start();
+    TEST_ASSERT_EQUAL(0, err);
+    err = location_service->gps_set_signal_monitoring(true);
+    TEST_ASSERT_EQUAL(0, err);
+    // wait satellites
+    for (int i = 0; i < 60; i++) {
+        ThisThread::sleep_for(1s);
+        modem->process_urc();
+        location_service->gps_get_signal_info(&info);
+        if (info.sats_in_view > 0) {
+            break;
+        }
+    }
+    TEST_ASSERT_NOT_EQUAL(0, info.sats_in_view);
+    TEST_ASSERT_TRUE(info.max_snr >= info.sats[0].snr);
+    err = location_service->gps_set_signal_monitoring(false);
+    TEST_ASSERT_EQUAL(0, err);
+    err = location_service->gps_stop();
+    TEST_ASSERT_EQUAL(0, err);
+}
+
+struct gps_locate_async_result_t {
+    EventFlags flags;
+    nsapi_error_t err;
+    SIM5320LocationService::coord_t coord;
+
+    void done(nsapi_error_t err, const SIM5320LocationService::coord_t &coord)
+    {
+        this->err = err;
+        this->coord = coord;
+        flags.set(0x01);
+    }
+};
+
+void test_gps_locate_async()
+{
+    EventQueue queue;
+    Thread queue_thread;
+    gps_locate_async_result_t result;
+    const size_t buf_size = 128;
+    char buf[buf_size];
+    int err;
+
+    queue_thread.start(callback(&queue, &EventQueue::dispatch_forever));
+
+    // check cancellation
+    err = location_service->gps_locate_async(&queue, callback(&result, &gps_locate_async_result_t::done));
+    TEST_ASSERT_EQUAL(0, err);
+    TEST_ASSERT_TRUE(location_service->gps_locate_is_running());
+    err = location_service->gps_locate_async(&queue, callback(&result, &gps_locate_async_result_t::done));
+    TEST_ASSERT_NOT_EQUAL(0, err);
+    ThisThread::sleep_for(5s);
+    err = location_service->gps_locate_cancel();
+    TEST_ASSERT_EQUAL(0, err);
+    TEST_ASSERT_FALSE(location_service->gps_locate_is_running());
+    TEST_ASSERT_EQUAL(0, result.flags.get());
+
+    // check explicit queue requirement
+    err = location_service->gps_locate_async(nullptr, callback(&result, &gps_locate_async_result_t::done));
+    TEST_ASSERT_EQUAL(NSAPI_ERROR_PARAMETER, err);
+    TEST_ASSERT_FALSE(location_service->gps_locate_is_running());
+
+    // check restart right after cancellation: events of the cancelled operation should be ignored
+    err = location_service->gps_locate_async(&queue, callback(&result, &gps_locate_async_result_t::done));
+    TEST_ASSERT_EQUAL(0, err);
+    err = location_service->gps_locate_cancel();
+    TEST_ASSERT_EQUAL(0, err);
+    err = location_service->gps_locate_async(&queue, callback(&result, &gps_locate_async_result_t::done));
+    TEST_ASSERT_EQUAL(0, err);
+    ThisThread::sleep_for(5s);
+    TEST_ASSERT_TRUE(location_service->gps_locate_is_running());
+    err = location_service->gps_locate_cancel();
+    TEST_ASSERT_EQUAL(0, err);
+    TEST_ASSERT_FALSE(location_service->gps_locate_is_running());
+    TEST_ASSERT_EQUAL(0, result.flags.get());
+
+    // locate coordinates
+    result.err = -1;
+    COORD_CLEAR(result.coord);
+    err = location_service->gps_locate_async(&queue, callback(&result, &gps_locate_async_result_t::done));
+    TEST_ASSERT_EQUAL(0, err);
+    // check that other AT commands can be used during operation
+    ThisThread::sleep_for(10s);
+    err = modem->get_information()->get_manufacturer(buf, buf_size);
+    TEST_ASSERT_EQUAL(0, err);
+    result.flags.wait_any(0x01, 600000);
+    TEST_ASSERT_EQUAL(0, result.err);
+    COORD_VERIFY(result.coord);
+    TEST_ASSERT_FALSE(location_service->gps_locate_is_running());
+
+    queue.break_dispatch();
+    queue_thread.join();
+}
+
+void test_last_location()
+{
+    SIM5320LocationService::location_t location;
+    SIM5320LocationService::coord_t coord;
+    SIM5320LocationService::coord_fixed_t cell_coord;
+    bool has_coord;
+    int err;
+
+    location_service->clear_last_location();
+    TEST_ASSERT_FALSE(location_service->get_last_location(&location, 600s));
+
+    // fix should be cached
+    COORD_CLEAR(coord);
+    has_coord = false;
+    err = location_service->gps_locate(&coord, has_coord);
+    TEST_ASSERT_EQUAL(0, err);
+    TEST_ASSERT_EQUAL(true, has_coord);
+    TEST_ASSERT_TRUE(location_service->get_last_location(&location, 60s));
+    TEST_ASSERT_EQUAL(SIM5320LocationService::LOCATION_SOURCE_GPS, location.source);
+    TEST_ASSERT_TRUE(location.accuracy > 0);
+    COORD_CLEAR(coord);
+    TEST_ASSERT_TRUE(location_service->get_last_location(&coord, 60s));
+    COORD_VERIFY(coord);
+    // check age
+    ThisThread::sleep_for(2s);
+    TEST_ASSERT_FALSE(location_service->get_last_location(&location, 1s));
+
+    // less accurate location shouldn't replace fresh GPS fix
+    cell_coord = location.coord;
+    location_service->set_last_location(cell_coord, SIM5320LocationService::LOCATION_SOURCE_CELL, 1000, 60s);
+    TEST_ASSERT_TRUE(location_service->get_last_location(&location, 60s));
+    TEST_ASSERT_EQUAL(SIM5320LocationService::LOCATION_SOURCE_GPS, location.source);
+    location_service->set_last_location(cell_coord, SIM5320LocationService::LOCATION_SOURCE_CELL, 1000);
+    TEST_ASSERT_TRUE(location_service->get_last_location(&location, 60s));
+    TEST_ASSERT_EQUAL(SIM5320LocationService::LOCATION_SOURCE_CELL, location.source);
+    TEST_ASSERT_EQUAL(1000, location.accuracy);
+}
+
 // test cases description
 #define SIM5320Case(test_fun) Case(#test_fun, app_case_setup_handler, test_fun, app_case_teardown_handler, greentea_case_failure_continue_handler)
 static Case cases[] = {
@@ -288,6 +467,10 @@ static Case cases[] = {
     // note: AT+CGPSXD may not return code that causes failure. TODO: check
     // SIM5320Case(test_gps_xtra),
     SIM5320Case(test_apgs),
+    SIM5320Case(test_gps_stream),
+    SIM5320Case(test_gps_signal_info),
+    SIM5320Case(test_gps_locate_async),
+    SIM5320Case(test_last_location),
 };
 static Specification specification(greentea_test_setup_handler, cases);
 
@@ -183,12 +183,48 @@ void test_udp_usage()
     TEST_ASSERT(current_time > time_2019);
 }
 
+void test_network_reconnect_settings_cache()
+{
+    int err;
+    uint32_t write_count;
+    CellularContext *cellular_context = modem->get_context();
+    SIM5320SettingsCache *settings_cache = modem->get_settings_cache();
+
+    // stop network that is started by test setup
+    err = cellular_context->disconnect();
+    TEST_ASSERT_EQUAL(0, err);
+    err = modem->request_to_stop();
+    TEST_ASSERT_EQUAL(0, err);
+
+    // first cycle can write settings
+    err = modem->network_up();
+    TEST_ASSERT_EQUAL(0, err);
+    err = modem->network_down();
+    TEST_ASSERT_EQUAL(0, err);
+    write_count = settings_cache->get_write_count();
+
+    // second cycle should skip them
+    err = modem->network_up();
+    TEST_ASSERT_EQUAL(0, err);
+    TEST_ASSERT_EQUAL(write_count, settings_cache->get_write_count());
+    err = modem->network_down();
+    TEST_ASSERT_EQUAL(0, err);
+    TEST_ASSERT_EQUAL(write_count, settings_cache->get_write_count());
+
+    // restore network for other tests
+    err = modem->request_to_start();
+    TEST_ASSERT_EQUAL(0, err);
+    err = cellular_context->connect();
+    TEST_ASSERT_EQUAL(0, err);
+}
+
 // test cases description
 #define SIM5320Case(test_fun) Case(#test_fun, case_setup_handler, test_fun, greentea_case_teardown_handler, greentea_case_failure_continue_handler)
 static Case cases[] = {
     SIM5320Case(test_dns_usage),
     SIM5320Case(test_tcp_usage),
     SIM5320Case(test_udp_usage),
+    SIM5320Case(test_network_reconnect_settings_cache),
 };
 static Specification specification(test_setup_handler, cases, test_teardown_handler);
 
@@ -201,7 +237,7 @@ int main()
 
     // host handshake
     // note: should be invoked here or in the test_setup_handler
-    GREENTEA_SETUP(80, "default_auto");
+    GREENTEA_SETUP(200, "default_auto");
     // run tests
     return !Harness::run(specification);
 }
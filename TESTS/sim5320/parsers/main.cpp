@@ -0,0 +1,110 @@
+/**
+ * Test of the AT response parsers.
+ *
+ * The parsers are checked with known strings, so the test doesn't use the device and doesn't require any SIM card.
+ */
+#include <string.h>
+#include <time.h>
+
+#include "mbed.h"
+
+#include "greentea-client/test_env.h"
+#include "unity.h"
+#include "utest.h"
+
+#include "sim5320_LocationService.h"
+#include "sim5320_utils.h"
+
+using namespace utest::v1;
+using namespace sim5320;
+
+static time_t build_time(int year, int month, int mday, int hour, int minute, int second)
+{
+    struct tm timeinfo;
+    memset(&timeinfo, 0, sizeof(timeinfo));
+    timeinfo.tm_year = year - 1900;
+    timeinfo.tm_mon = month - 1;
+    timeinfo.tm_mday = mday;
+    timeinfo.tm_hour = hour;
+    timeinfo.tm_min = minute;
+    timeinfo.tm_sec = second;
+    return mktime(&timeinfo);
+}
+
+void test_parse_negative_int()
+{
+    int value = 0;
+
+    // time zone of the "+CCLK" response is signed number of quarters of an hour
+    SimpleStringParser parser("-16+08");
+    TEST_ASSERT_EQUAL(0, parser.consume_int(&value));
+    TEST_ASSERT_EQUAL(-16, value);
+    TEST_ASSERT_EQUAL(0, parser.consume_int(&value));
+    TEST_ASSERT_EQUAL(8, value);
+    TEST_ASSERT_TRUE(parser.is_finshed());
+
+    SimpleStringParser invalid_parser("-");
+    TEST_ASSERT_NOT_EQUAL(0, invalid_parser.consume_int(&value));
+}
+
+void test_parse_cgpsinfo()
+{
+    SIM5320LocationService::coord_fixed_t coord;
+    bool ff_flag;
+    // device dates are affected by GPS week rollover issue, so parser adds 1024 weeks
+    const time_t rollover_shift = 7 * 1024 * 24 * 60 * 60;
+
+    // north/east hemispheres
+    TEST_ASSERT_EQUAL(0, SIM5320LocationService::parse_cgpsinfo("3113.343286,N,12121.234064,E,250311,072809.3,44.1,0.0,0", &coord, ff_flag));
+    TEST_ASSERT_TRUE(ff_flag);
+    TEST_ASSERT_EQUAL_INT32(312223881, coord.latitude);
+    TEST_ASSERT_EQUAL_INT32(1213539011, coord.longitude);
+    TEST_ASSERT_EQUAL_INT32(4410, coord.altitude);
+    TEST_ASSERT_EQUAL(build_time(2011, 3, 25, 7, 28, 9) + rollover_shift, coord.time);
+    TEST_ASSERT_EQUAL(300, coord.time_ms);
+    TEST_ASSERT_EQUAL_INT32(0, coord.speed);
+    TEST_ASSERT_EQUAL_INT32(0, coord.course);
+
+    // south/west hemispheres, negative altitude and longitude near 180 degrees
+    TEST_ASSERT_EQUAL(0, SIM5320LocationService::parse_cgpsinfo("3352.128900,S,17959.999999,W,010120,235959.0,-12.5,1.0,270.25", &coord, ff_flag));
+    TEST_ASSERT_TRUE(ff_flag);
+    TEST_ASSERT_EQUAL_INT32(-338688150, coord.latitude);
+    TEST_ASSERT_EQUAL_INT32(-1800000000, coord.longitude);
+    TEST_ASSERT_EQUAL_INT32(-1250, coord.altitude);
+    TEST_ASSERT_EQUAL(build_time(2020, 1, 1, 23, 59, 59) + rollover_shift, coord.time);
+    TEST_ASSERT_EQUAL(0, coord.time_ms);
+    TEST_ASSERT_EQUAL_INT32(51, coord.speed);
+    TEST_ASSERT_EQUAL_INT32(27025, coord.course);
+
+    // altitude below 1 meter
+    TEST_ASSERT_EQUAL(0, SIM5320LocationService::parse_cgpsinfo("0000.000000,N,0000.000000,E,010120,000000.0,-0.5,0.0,0", &coord, ff_flag));
+    TEST_ASSERT_TRUE(ff_flag);
+    TEST_ASSERT_EQUAL_INT32(0, coord.latitude);
+    TEST_ASSERT_EQUAL_INT32(0, coord.longitude);
+    TEST_ASSERT_EQUAL_INT32(-50, coord.altitude);
+
+    // no fix
+    TEST_ASSERT_EQUAL(0, SIM5320LocationService::parse_cgpsinfo(",,,,,,,,", &coord, ff_flag));
+    TEST_ASSERT_FALSE(ff_flag);
+
+    // invalid format
+    TEST_ASSERT_NOT_EQUAL(0, SIM5320LocationService::parse_cgpsinfo("3113.343286,N", &coord, ff_flag));
+    TEST_ASSERT_FALSE(ff_flag);
+}
+
+// test cases description
+#define SIM5320Case(test_fun) Case(#test_fun, test_fun, greentea_case_failure_continue_handler)
+static Case cases[] = {
+    SIM5320Case(test_parse_negative_int),
+    SIM5320Case(test_parse_cgpsinfo),
+};
+static Specification specification(greentea_test_setup_handler, cases);
+
+// Entry point into the tests
+int main()
+{
+    // host handshake
+    GREENTEA_SETUP(30, "default_auto");
+    // run tests
+    return !Harness::run(specification);
+}
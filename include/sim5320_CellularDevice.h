@@ -15,6 +15,7 @@
 #include "sim5320_CellularSMS.h"
 #include "sim5320_FTPClient.h"
 #include "sim5320_LocationService.h"
+#include "sim5320_SettingsCache.h"
 #include "sim5320_TimeService.h"
 
 namespace sim5320 {
@@ -49,16 +50,36 @@ public:
     /**
      * Get current device power level.
      *
+     * The power level is cached, so AT command is sent only if it's unknown or @p force_refresh is set.
+     *
      * @param func_level
+     * @param force_refresh read power level from device
      * @return 0 on success, otherwise non-zero value
      */
-    virtual nsapi_error_t get_power_level(int &func_level);
+    virtual nsapi_error_t get_power_level(int &func_level, bool force_refresh = false);
 
     // CellularDevice
     virtual void set_timeout(int timeout) override;
 
     // AT_CellularDevice
     virtual nsapi_error_t init() override;
+    virtual nsapi_error_t shutdown() override;
+
+    /**
+     * Get cache of the device settings that have been written by driver.
+     *
+     * @return
+     */
+    SIM5320SettingsCache *get_settings_cache();
+
+    /**
+     * Read cached device settings with one AT command and drop values that differ from actual ones.
+     *
+     * It can be used if device settings could be changed outside of the driver.
+     *
+     * @return 0 on success, otherwise non-zero value
+     */
+    nsapi_error_t verify_settings_cache();
 
     static const size_t SUBSCRIBER_NUMBER_MAX_LEN = 16;
 
@@ -80,6 +101,26 @@ public:
      */
     virtual nsapi_error_t set_subscriber_number(const char *number);
 
+    /**
+     * Set phonebook initialization state.
+     *
+     * After device reset the SIM phonebook is loaded in background, and the device reports it with "PB DONE" message.
+     * If driver doesn't wait this message, it should mark phonebook as not ready, so operations that require it
+     * (SMS, subscriber number) will wait it.
+     *
+     * @param ready phonebook state flag
+     */
+    void set_phonebook_ready(bool ready);
+
+    /**
+     * Wait till SIM phonebook initialization is finished.
+     *
+     * If phonebook isn't ready within 48 seconds after device reset, the error will be returned.
+     *
+     * @return 0 on success, otherwise non-zero value
+     */
+    nsapi_error_t wait_phonebook_ready();
+
     //--------------------------------
     // Device interfaces
     //--------------------------------
@@ -196,6 +237,16 @@ protected:
         }
     };
 
+    SIM5320SettingsCache _settings_cache;
+
+    // phonebook initialization state
+    bool _phonebook_ready;
+    Timer _phonebook_timer;
+    void _urc_pb_done();
+
+    // device restart notification
+    void _urc_start();
+
     DeviceInterfaceManager<SIM5320CellularInformation, &SIM5320CellularDevice::open_information_base_impl> _information_service;
     DeviceInterfaceManager<SIM5320CellularNetwork, &SIM5320CellularDevice::open_network_base_impl> _network_service;
 #if MBED_CONF_CELLULAR_USE_SMS
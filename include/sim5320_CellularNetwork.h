@@ -6,6 +6,8 @@
 #include "ATHandler.h"
 #include "CellularNetwork.h"
 
+#include "sim5320_SettingsCache.h"
+
 namespace sim5320 {
 
 /**
@@ -14,6 +16,7 @@ namespace sim5320 {
 class SIM5320CellularNetwork : public CellularNetwork, private NonCopyable<SIM5320CellularNetwork> {
 protected:
     ATHandler &_at;
+    SIM5320SettingsCache *_settings_cache;
 
     Callback<void(nsapi_event_t, intptr_t)> _connection_status_cb;
     RadioAccessTechnology _op_act;
@@ -31,7 +34,7 @@ private:
     nsapi_error_t _read_and_process_reg_params(RegistrationType type);
 
 public:
-    SIM5320CellularNetwork(ATHandler &at_handler);
+    SIM5320CellularNetwork(ATHandler &at_handler, SIM5320SettingsCache *settings_cache = nullptr);
     virtual ~SIM5320CellularNetwork();
 
     // CellularNetwork interface
@@ -80,6 +83,18 @@ public:
      */
     nsapi_error_t get_active_access_technology(CellularNetwork::RadioAccessTechnology &op_rat);
 
+    /**
+     * Get network attach state.
+     *
+     * The state is updated by driver commands and "+CGEV" URC codes,
+     * so AT command is sent only if state is unknown or @p force_refresh is set.
+     *
+     * @param status
+     * @param force_refresh read state from device
+     * @return 0 on success, otherwise non-zero value
+     */
+    nsapi_error_t get_attach(AttachStatus &status, bool force_refresh);
+
 private:
 };
 }
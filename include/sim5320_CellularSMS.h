@@ -17,6 +17,8 @@
 
 namespace sim5320 {
 
+class SIM5320CellularDevice;
+
 /**
  * CellularSMS interface implementation.
  *
@@ -25,6 +27,7 @@ namespace sim5320 {
 class SIM5320CellularSMS : public CellularSMS, private NonCopyable<SIM5320CellularSMS> {
 protected:
     ATHandler &_at;
+    SIM5320CellularDevice *_device;
 
     Callback<void()> _cb;
     bool _use_8bit_encoding = true;
@@ -38,8 +41,19 @@ protected:
 protected:
     nsapi_error_t get_sms_message_mode(CellularSMS::CellularSMSMmode &mode);
 
+    /**
+     * Wait SIM phonebook initialization that is required for SMS operations.
+     */
+    nsapi_error_t wait_phonebook_ready();
+
 public:
-    SIM5320CellularSMS(ATHandler &at_handler);
+    /**
+     * Constructor.
+     *
+     * @param at_handler @c ATHandler object
+     * @param device device object to check phonebook state. If it's @c nullptr, then the phonebook is considered ready.
+     */
+    SIM5320CellularSMS(ATHandler &at_handler, SIM5320CellularDevice *device = nullptr);
     virtual ~SIM5320CellularSMS();
 
 public:
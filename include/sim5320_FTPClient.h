@@ -2,12 +2,16 @@
 #define SIM5320_FTPCLIENT_H
 
 #include "mbed.h"
+#include "mbed_chrono.h"
 
 #include "ATHandler.h"
 #include "CellularList.h"
 
 namespace sim5320 {
 
+class LZSSEncoder;
+class LZSSDecoder;
+
 /**
  * FTP client of the SIM5320
  */
@@ -25,6 +29,93 @@ private:
     char *_buffer;
     bool _cleanup_buffer;
 
+    // data transfer notifications
+    EventFlags _transfer_flags;
+    int _transfer_code;
+    void _urc_cftps_recv_event();
+    void _urc_cftpsget();
+
+    // double buffering of the uploaded data
+    EventQueue *_producer_queue;
+    EventQueue *_producer_own_queue;
+    Thread *_producer_thread;
+    uint8_t *_producer_buffer;
+    bool _cleanup_producer_buffer;
+
+    // estimated upload bandwidth (bytes per second)
+    uint32_t _put_bandwidth;
+
+    // release ATHandler lock between data blocks
+    bool _cooperative_mode;
+    // lock to prevent FTP commands of other threads during transfers
+    Mutex _session_mutex;
+
+    // transfer compression
+    LZSSEncoder *_encoder;
+    LZSSDecoder *_decoder;
+
+    // parameters of the current session to restore it
+    struct session_params_t {
+        bool valid;
+        char host[64];
+        int port;
+        int protocol;
+        char username[32];
+        char password[32];
+    };
+    session_params_t _session_params;
+    nsapi_error_t _login(const char *host, int port, int protocol, const char *username, const char *password);
+    nsapi_error_t _relogin();
+    bool _is_session_lost();
+
+    // session keep-alive and lazy restoration
+    friend struct session_lock_t;
+    int _session_lock_depth;
+    bool _connected;
+    volatile bool _session_lost;
+    bool _auto_reconnect;
+    Kernel::Clock::time_point _last_activity;
+    EventQueue *_keep_alive_queue;
+    int _keep_alive_event_id;
+    mbed::chrono::milliseconds_u32 _keep_alive_interval;
+    void _keep_alive_check();
+    void _urc_cftpsnotify();
+    void _on_session_error(int err);
+
+    // background transfers between server and modem storage
+    volatile int _modem_transfer_code;
+    volatile bool _modem_transfer_pending;
+    Callback<void(nsapi_error_t err)> _modem_transfer_cb;
+    void _urc_cftps_file();
+    nsapi_error_t _start_modem_transfer(const char *cmd, const char *remote_path, int modem_dir, Callback<void(nsapi_error_t err)> done_cb);
+
+public:
+    /**
+     * Statistics of the current or last data transfer.
+     */
+    struct transfer_stats_t {
+        /** number of the transferred bytes */
+        uint32_t bytes_done;
+        /** transfer duration in milliseconds */
+        uint32_t elapsed_ms;
+        /** throughput of the last period (bytes per second) */
+        uint32_t current_throughput;
+        /** average throughput since transfer start (bytes per second) */
+        uint32_t average_throughput;
+        /** number of the waits, when device download cache was empty */
+        uint32_t cache_empty_waits;
+        /** number of the waits, when device upload buffer was full */
+        uint32_t buffer_full_waits;
+        /** last reported amount of the data in the device upload buffer */
+        uint32_t modem_pending;
+    };
+
+private:
+    // transfer statistics
+    transfer_stats_t _transfer_stats;
+    Callback<void(const transfer_stats_t &stats)> _progress_cb;
+    friend struct transfer_stats_tracker_t;
+
 public:
     static const size_t BUFFER_SIZE = 1024;
 
@@ -40,6 +131,21 @@ public:
      */
     nsapi_error_t set_buffer(uint8_t *buf);
 
+    /**
+     * Enable/disable double buffering of the uploaded data.
+     *
+     * If it's enabled, the ::put method requests next data block from the @c data_writer callback in the producer context,
+     * while the current block is transmitted to the device, so local storage reading latency is hidden behind UART transmission.
+     * The @c data_writer is invoked from the @p producer_queue or, if it's @c nullptr, from the driver thread with a stack
+     * of the `sim5320-driver.ftp_producer_stack_size` size.
+     *
+     * @param enabled double buffering flag
+     * @param producer_queue event queue to invoke @c data_writer callback or @c nullptr to use driver thread
+     * @param buf optional second buffer of the BUFFER_SIZE size. If it isn't set, it will be allocated.
+     * @return 0 on success, non-zero on failure
+     */
+    nsapi_error_t set_double_buffering(bool enabled, EventQueue *producer_queue = nullptr, uint8_t *buf = nullptr);
+
     /**
      * FTP protocol type.
      */
@@ -113,6 +219,124 @@ public:
      */
     nsapi_error_t disconnect();
 
+    /**
+     * Enable/disable lazy session restoration.
+     *
+     * If it's enabled and FTP session has been lost (server closed connection, network error or idle timeout),
+     * the next FTP operation logs in again using parameters of the last ::connect call before command execution.
+     * The failed operation itself isn't repeated. If the session cannot be restored, the operation returns
+     * the login error without command execution.
+     *
+     * By default it's disabled.
+     *
+     * @param enabled flag
+     */
+    void set_auto_reconnect(bool enabled);
+
+    /**
+     * Set session keep-alive interval.
+     *
+     * If session is idle longer than @p interval, a cheap command ("AT+CFTPSPWD") is sent to prevent
+     * server idle timeout and detect closed sessions. The check is skipped if an FTP operation or a background
+     * transfer (::fetch_to_modem, ::push_from_modem) is in progress, as a failed check during the transfer
+     * would lead to relogin that aborts it. The interval should be less than server idle timeout.
+     *
+     * The check waits @c ATHandler lock and can take up to FTP response timeout, so @p queue shouldn't be
+     * used for time critical events (the mbed shared event queue isn't recommended).
+     *
+     * @param interval keep-alive interval or 0 to disable keep-alive
+     * @param queue event queue to run keep-alive checks. It's required if @p interval isn't zero.
+     * @return 0 on success, non-zero on failure
+     */
+    nsapi_error_t set_keep_alive(mbed::chrono::milliseconds_u32 interval, EventQueue *queue = nullptr);
+
+    /**
+     * Check if FTP session is known to be lost.
+     *
+     * @return @c true if session has been closed by server or network error
+     */
+    bool is_session_lost() const;
+
+    /**
+     * FTP job types.
+     */
+    enum JobType {
+        /** upload local file `local_path` to `remote_path` */
+        JOB_UPLOAD = 0,
+        /** download `remote_path` file to `local_path` */
+        JOB_DOWNLOAD,
+        /** create `remote_path` directory */
+        JOB_MKDIR,
+        /** remove `remote_path` file */
+        JOB_RMFILE,
+        /** remove `remote_path` empty directory */
+        JOB_RMDIR
+    };
+
+    /**
+     * FTP job description.
+     *
+     * The job object and its paths are owned by user code and should be valid till end of the job execution.
+     */
+    struct job_t {
+        /** job type */
+        JobType type;
+        /** local file path (upload and download jobs only) */
+        const char *local_path;
+        /** ftp path */
+        const char *remote_path;
+        /** job result. It's set after job execution */
+        nsapi_error_t result;
+        /** number of the done attempts. It's set after job execution */
+        int attempts;
+
+        job_t *next;
+    };
+
+    /**
+     * Add job to the queue.
+     *
+     * The jobs are executed by ::run_jobs method. The method can be invoked from other threads during jobs execution.
+     *
+     * @param job job object
+     */
+    void enqueue_job(job_t *job);
+
+    /**
+     * Set retry policy of the jobs.
+     *
+     * Only transient errors (connection loss, network errors, transfer failures) are retried.
+     * If a job fails, because FTP session has been lost, client logs in again using parameters of the last ::connect call.
+     *
+     * @param max_attempts maximal number of the attempts per job (default 3)
+     * @param retry_delay delay between attempts (default 1 second)
+     */
+    void set_job_retry_policy(int max_attempts, mbed::chrono::milliseconds_u32 retry_delay);
+
+    /**
+     * Execute all queued jobs in order within current FTP session.
+     *
+     * The client should be connected before invocation. The jobs are removed from the queue,
+     * and results are saved to job objects.
+     *
+     * If the session is lost between attempts, it's restored before the next one. If it cannot be restored,
+     * the current and remaining jobs fail with the login error without further attempts.
+     *
+     * @param num_failed optional number of the failed jobs
+     * @return 0 if all jobs are succeeded, otherwise error code of the first failed job
+     */
+    nsapi_error_t run_jobs(size_t *num_failed = nullptr);
+
+private:
+    // job queue
+    job_t *_jobs_head;
+    job_t *_jobs_tail;
+    int _job_max_attempts;
+    mbed::chrono::milliseconds_u32 _job_retry_delay;
+    job_t *_dequeue_job();
+    nsapi_error_t _execute_job(job_t *job);
+
+public:
     /**
      * Get current working directory.
      *
@@ -182,13 +406,13 @@ public:
     nsapi_error_t rmdir(const char *path);
 
 private:
-    nsapi_error_t _rmtree_impl(char *path_buf, size_t path_buf_len);
+    nsapi_error_t _rmtree_impl(char *path_buf, size_t path_buf_len, char *names_buf, size_t names_buf_len);
 
 public:
     /**
      * Remove directory recursivy on a ftp server.
      *
-     * warning: this method should be used for tests only as it can use dynamic memory allocation operations
+     * The method doesn't use dynamic memory allocation, but full path of the nested entries is limited by 255 symbols.
      *
      * @param path directory path
      * @param remove_root if it's @c false, then remove directory content, but don't delete directory itself
@@ -207,9 +431,17 @@ public:
     struct dir_entry_t {
         char *name;
         /**
-         * DT_REG, DT_DIR or DT_UNKNOWN.
+         * DT_REG, DT_DIR, DT_LNK or DT_UNKNOWN.
          */
         char d_type;
+        /**
+         * File size or -1 if it's unknown.
+         */
+        long size;
+        /**
+         * Modification time or 0 if it's unknown.
+         */
+        time_t mtime;
 
         dir_entry_t *next;
 
@@ -224,12 +456,36 @@ public:
      */
     typedef CellularList<dir_entry_t> dir_entry_list_t;
 
+    /**
+     * Directory entry that is passed to the listdir callback.
+     *
+     * The object and its name are valid only during callback invocation.
+     */
+    struct dir_entry_view {
+        /** entry name */
+        const char *name;
+        /**
+         * DT_REG, DT_DIR, DT_LNK or DT_UNKNOWN.
+         */
+        char d_type;
+        /**
+         * File size or -1 if it's unknown.
+         */
+        long size;
+        /**
+         * Modification time or 0 if it's unknown.
+         *
+         * note: if server omits year for recent files, it's taken from the current system time.
+         */
+        time_t mtime;
+    };
+
     /**
      * Get list of the files in the specified directories.
      *
      * It isn't recommended to use this function for a production as it uses dynamic memory allocation operations.
      *
-     * warning: the method cannot process correctly names that contain non-ascii symbols or spaces.
+     * Both unix and DOS listing formats are supported.
      *
      * @param path
      * @param dir_entry_list
@@ -237,6 +493,52 @@ public:
      */
     nsapi_error_t listdir(const char *path, dir_entry_list_t *dir_entry_list);
 
+    /**
+     * Iterate over files of the specified directory.
+     *
+     * Unlike list version, this method doesn't use dynamic memory allocation. Each entry is passed to the @p entry_cb
+     * callback as soon as it's parsed.
+     *
+     * @note
+     * The callback is invoked during data transfer, so it shouldn't use other FTP client methods.
+     *
+     * The unix ("ls -l" like) and DOS listing formats are supported, so entries contain sizes and modification
+     * times and names can contain spaces. Listing lines are truncated to 255 symbols.
+     *
+     * @param path directory path
+     * @param entry_cb callback that accepts directory entries
+     * @return 0 on success, non-zero on failure
+     */
+    nsapi_error_t listdir(const char *path, Callback<void(const dir_entry_view &entry)> entry_cb);
+
+    /**
+     * Transfer digest algorithm.
+     */
+    enum DigestType {
+        /** CRC-32 (IEEE 802.3) */
+        DIGEST_CRC32 = 0,
+        /** SHA-256 */
+        DIGEST_SHA256 = 1
+    };
+
+    /**
+     * Digest of the transferred data.
+     */
+    struct digest_t {
+        /** digest algorithm. It should be set before transfer */
+        DigestType type;
+        /** digest value: 4 bytes of the CRC-32 (big-endian) or 32 bytes of the SHA-256 */
+        uint8_t value[32];
+    };
+
+    /**
+     * Get digest size in bytes.
+     *
+     * @param type digest algorithm
+     * @return digest size
+     */
+    static size_t get_digest_size(DigestType type);
+
     /**
      * Put file on an ftp server.
      *
@@ -244,9 +546,11 @@ public:
      * that it can accept. The callback should return actual amount of data that it put into `data`.
      * If returned value is `0`, then transmission will be finished.
      *
+     * If double buffering is enabled (see ::set_double_buffering), the callback is invoked from the producer context.
+     *
      * @note
      * This operation can be long and lock ATHandler object, so you cannot use other sim5320 functionality
-     * till end of this operation.
+     * till end of this operation, if cooperative mode isn't enabled (see ::set_cooperative_mode).
      *
      * @param path ftp file path
      * @param data_writer callback to provide data
@@ -254,6 +558,20 @@ public:
      */
     nsapi_error_t put(const char *path, Callback<ssize_t(uint8_t *data, size_t size)> data_writer);
 
+    /**
+     * Put file on an ftp server and calculate digest of the sent data.
+     *
+     * The digest is calculated on the fly, so data doesn't need to be read again.
+     * If compression is enabled, the digest is calculated for uncompressed data.
+     *
+     * @param path ftp file path
+     * @param data_writer callback
+     * @param digest digest algorithm and result. If it's @c nullptr, digest isn't calculated
+     * @param expected_digest optional expected digest. If calculated digest differs, `MBED_ERROR_INVALID_DATA_DETECTED` is returned
+     * @return 0 on success, non-zero on failure
+     */
+    nsapi_error_t put(const char *path, Callback<ssize_t(uint8_t *data, size_t size)> data_writer, digest_t *digest, const uint8_t *expected_digest = nullptr);
+
     /**
      * Put file on an ftp server.
      *
@@ -266,6 +584,80 @@ public:
      */
     nsapi_error_t put(const char *path, uint8_t *buf, size_t len);
 
+    /**
+     * Enable/disable cooperative transfer mode.
+     *
+     * By default ::put, ::get and ::listdir methods lock ATHandler object till end of the transfer.
+     * In the cooperative mode the lock is released between data blocks, so other threads can use
+     * sockets, SMS, GPS and other device functions during long transfers. Other FTP operations
+     * still wait end of the current transfer.
+     *
+     * @param enabled cooperative mode flag
+     */
+    void set_cooperative_mode(bool enabled);
+
+    /**
+     * Enable/disable compression of the transferred files.
+     *
+     * If compression is enabled, ::put compresses data before sending and ::get decompresses received data
+     * with a streaming LZSS codec (see sim5320::LZSSCodec for format description), so the server side should store
+     * compressed files and process them with compatible codec. The codec window is set by
+     * `sim5320-driver.ftp_compression_window_size` option.
+     *
+     * The codec buffers are allocated when compression is enabled and released when it's disabled.
+     *
+     * @note
+     * File sizes on the server correspond to compressed data, so ::get with offset and ::download_resume
+     * aren't supported in this mode, and ::sync_dir should be used with ::SYNC_POLICY_MISSING policy.
+     *
+     * @param enabled compression flag
+     * @return 0 on success, non-zero on failure
+     */
+    nsapi_error_t set_compression(bool enabled);
+
+    /**
+     * Get estimated upload bandwidth.
+     *
+     * The ::put method adjusts data block sizes and delays between them according device upload rate.
+     * This method returns the rate that has been estimated during last uploads.
+     *
+     * @return upload bandwidth in bytes per second, or 0 if it's unknown
+     */
+    uint32_t get_upload_bandwidth() const;
+
+    /**
+     * Set initial upload bandwidth estimation.
+     *
+     * It can be used to restore estimation that has been saved by ::get_upload_bandwidth in previous session.
+     * The estimation is used only as a hint for delays between device buffer queries, and it's corrected during upload.
+     *
+     * @param bandwidth upload bandwidth in bytes per second, or 0 if it's unknown
+     */
+    void set_upload_bandwidth(uint32_t bandwidth);
+
+    /**
+     * Set transfer progress callback.
+     *
+     * The callback is invoked by ::put, ::get, ::upload, ::download and other transfer methods after each data block
+     * and during waits of the device, so stalled transfers can be detected by throughput values.
+     *
+     * @note
+     * The callback is invoked during data transfer and ATHandler can be locked, so it shouldn't use FTP client
+     * or other device methods.
+     *
+     * @param progress_cb progress callback or @c nullptr to disable it
+     */
+    void set_progress_callback(Callback<void(const transfer_stats_t &stats)> progress_cb);
+
+    /**
+     * Get statistics of the current or last data transfer.
+     *
+     * The method can be invoked from other threads during transfer.
+     *
+     * @param stats transfer statistics
+     */
+    void get_transfer_stats(transfer_stats_t &stats) const;
+
     /**
      * Get file from ftp server.
      *
@@ -279,70 +671,245 @@ public:
     nsapi_error_t get(const char *path, Callback<ssize_t(uint8_t *data, size_t size)> data_reader);
 
     /**
-     * Download file from ftp server.
+     * Get file from ftp server and calculate digest of the received data.
+     *
+     * The digest is calculated on the fly for data that has been accepted by @p data_reader, so data doesn't need
+     * to be read again. If compression is enabled, the digest is calculated for decompressed data.
+     *
+     * @param path ftp file path
+     * @param data_reader callback
+     * @param digest digest algorithm and result. If it's @c nullptr, digest isn't calculated
+     * @param expected_digest optional expected digest. If calculated digest differs, `MBED_ERROR_INVALID_DATA_DETECTED` is returned
+     * @return 0 on success, non-zero on failure
+     */
+    nsapi_error_t get(const char *path, Callback<ssize_t(uint8_t *data, size_t size)> data_reader, digest_t *digest, const uint8_t *expected_digest = nullptr);
+
+    /**
+     * Get file from ftp server starting from the given position.
+     *
+     * It can be used to continue interrupted transfer.
      *
+     * @param path ftp file path
+     * @param offset file position to start transfer from
+     * @param data_reader callback
+     * @return 0 on success, non-zero on failure
+     */
+    nsapi_error_t get(const char *path, long offset, Callback<ssize_t(uint8_t *data, size_t size)> data_reader);
+
+    /**
+     * Download file from ftp server.
      *
      * @param remote_path ftp file path
-     *  @param local_path destination path
+     * @param local_path destination path
+     * @param digest optional digest algorithm and result (see ::get)
+     * @param expected_digest optional expected digest
      * @return 0 on success, non-zero on failure
      */
-    nsapi_error_t download(const char *remote_path, const char *local_path);
+    nsapi_error_t download(const char *remote_path, const char *local_path, digest_t *digest = nullptr, const uint8_t *expected_digest = nullptr);
 
     /**
      * Download file from ftp server.
      *
      * @param remote_path ftp file path
      * @param local_file local file descriptor (use fopen function to get it)
+     * @param digest optional digest algorithm and result (see ::get)
+     * @param expected_digest optional expected digest
      * @return 0 on success, non-zero on failure
      */
-    nsapi_error_t download(const char *remote_path, FILE *local_file);
+    nsapi_error_t download(const char *remote_path, FILE *local_file, digest_t *digest = nullptr, const uint8_t *expected_digest = nullptr);
 
     /**
      * Download file from ftp server.
      *
      * @param remote_path ftp file path
      * @param local_file local file descriptor (use open function to get it)
+     * @param digest optional digest algorithm and result (see ::get)
+     * @param expected_digest optional expected digest
+     * @return 0 on success, non-zero on failure
+     */
+    nsapi_error_t download(const char *remote_path, int local_file, digest_t *digest = nullptr, const uint8_t *expected_digest = nullptr);
+
+    /**
+     * Continue file downloading from ftp server.
+     *
+     * If local file exists, only remaining file part is requested from server and appended to the local file.
+     * If local file is bigger than remote one, it's downloaded again.
+     *
+     * @param remote_path ftp file path
+     * @param local_path destination path
      * @return 0 on success, non-zero on failure
      */
-    nsapi_error_t download(const char *remote_path, int local_file);
+    nsapi_error_t download_resume(const char *remote_path, const char *local_path);
 
     /**
      * Upload file to ftp server.
      *
      * @param local_path local file location
      * @param remote_path ftp file path
+     * @param digest optional digest algorithm and result (see ::put)
+     * @param expected_digest optional expected digest
      * @return 0 on success, non-zero on failure
      */
-    nsapi_error_t upload(const char *local_path, const char *remote_path);
+    nsapi_error_t upload(const char *local_path, const char *remote_path, digest_t *digest = nullptr, const uint8_t *expected_digest = nullptr);
 
     /**
      * Upload file to ftp server.
      *
      * @param local_file local file descriptor (use fopen function to get it)
      * @param remote_path ftp file path
+     * @param digest optional digest algorithm and result (see ::put)
+     * @param expected_digest optional expected digest
      * @return 0 on success, non-zero on failure
      */
-    nsapi_error_t upload(FILE *local_file, const char *remote_path);
+    nsapi_error_t upload(FILE *local_file, const char *remote_path, digest_t *digest = nullptr, const uint8_t *expected_digest = nullptr);
 
     /**
      * Upload file to ftp server.
      *
      * @param local_file local file descriptor (use open function to get it)
      * @param remote_path ftp file path
+     * @param digest optional digest algorithm and result (see ::put)
+     * @param expected_digest optional expected digest
      * @return 0 on success, non-zero on failure
      */
-    nsapi_error_t upload(int local_file, const char *remote_path);
+    nsapi_error_t upload(int local_file, const char *remote_path, digest_t *digest = nullptr, const uint8_t *expected_digest = nullptr);
+
+    /**
+     * Modem storage directories.
+     */
+    enum ModemDir {
+        /** "C:/" directory */
+        MODEM_DIR_C = 1,
+        /** "D:/" directory (memory card) */
+        MODEM_DIR_D = 2
+    };
+
+    /**
+     * Start file download from ftp server to the modem storage.
+     *
+     * The file is transferred by the device itself and saved with the same name as remote one
+     * (e.g. "/logs/data.bin" -> "C:/data.bin"), so UART and ATHandler are free during transfer.
+     * The completion is reported by URC code, so use URC dispatcher (see sim5320::SIM5320::start_urc_dispatcher)
+     * or ::wait_modem_transfer to get it.
+     *
+     * @note
+     * Other FTP operations shouldn't be used till transfer completion. Keep-alive checks and automatic session
+     * restoration (see ::set_auto_reconnect) are suspended till transfer completion, as they can abort it.
+     *
+     * @param remote_path ftp file path
+     * @param modem_dir modem storage directory
+     * @param done_cb optional completion callback. It's invoked from URC context with transfer result, so it shouldn't use AT commands.
+     * @return 0 if transfer has been started, non-zero on failure
+     */
+    nsapi_error_t fetch_to_modem(const char *remote_path, ModemDir modem_dir = MODEM_DIR_C, Callback<void(nsapi_error_t err)> done_cb = nullptr);
+
+    /**
+     * Start file upload from the modem storage to ftp server.
+     *
+     * The modem file should have the same name as remote one (e.g. "C:/data.bin" -> "/logs/data.bin").
+     * See ::fetch_to_modem for details.
+     *
+     * @param remote_path ftp file path
+     * @param modem_dir modem storage directory
+     * @param done_cb optional completion callback. It's invoked from URC context with transfer result, so it shouldn't use AT commands.
+     * @return 0 if transfer has been started, non-zero on failure
+     */
+    nsapi_error_t push_from_modem(const char *remote_path, ModemDir modem_dir = MODEM_DIR_C, Callback<void(nsapi_error_t err)> done_cb = nullptr);
+
+    /**
+     * Wait completion of the ::fetch_to_modem or ::push_from_modem transfer.
+     *
+     * ATHandler isn't locked between URC code checks.
+     *
+     * @param timeout maximal wait time
+     * @return transfer result (0 if no transfer has been started) or NSAPI_ERROR_TIMEOUT
+     */
+    nsapi_error_t wait_modem_transfer(mbed::chrono::milliseconds_u32 timeout);
+
+    /**
+     * Read file from the modem storage.
+     *
+     * The file is read by large blocks, and ATHandler lock is released between them in cooperative mode.
+     *
+     * @param modem_path full file path (e.g. "C:/data.bin")
+     * @param data_reader callback with the same semantic as ::get callback
+     * @param offset start file position
+     * @return 0 on success, non-zero on failure
+     */
+    nsapi_error_t read_modem_file(const char *modem_path, Callback<ssize_t(uint8_t *data, size_t size)> data_reader, long offset = 0);
+
+    /**
+     * Delete file from the modem storage.
+     *
+     * @param modem_path full file path (e.g. "C:/data.bin")
+     * @return 0 on success, non-zero on failure
+     */
+    nsapi_error_t delete_modem_file(const char *modem_path);
+
+    /**
+     * Directory synchronization policy.
+     */
+    enum SyncPolicy {
+        /** upload only files that are missed on the server */
+        SYNC_POLICY_MISSING = 0,
+        /** upload missed files and files with different size */
+        SYNC_POLICY_SIZE = 1,
+        /** upload missed files, files with different size and files that are newer than remote ones (if modification time is available) */
+        SYNC_POLICY_SIZE_MTIME = 2,
+        /** upload all files */
+        SYNC_POLICY_ALL = 3
+    };
+
+    /**
+     * Directory synchronization summary.
+     */
+    struct sync_summary_t {
+        /** number of the checked local files */
+        uint32_t files_checked;
+        /** number of the uploaded files */
+        uint32_t files_uploaded;
+        /** number of the bytes that have been sent to server (compressed size if compression is enabled) */
+        uint64_t bytes_uploaded;
+    };
+
+    /**
+     * Upload new and changed files of a local directory to ftp server.
+     *
+     * The method reads remote directory listing once, compares local files with remote ones according
+     * @p policy and uploads only files that need to be updated. If remote directory doesn't exist, it's created.
+     * Subdirectories aren't processed.
+     *
+     * The method remembers up to `sim5320-driver.ftp_sync_max_remote_entries` remote files, that are allocated
+     * on a heap during the call (16 bytes per entry). Other local files are considered as changed.
+     *
+     * @param local_dir local directory
+     * @param remote_dir ftp directory
+     * @param policy file comparison policy
+     * @param summary optional transfer summary. It's filled even if synchronization fails.
+     * @return 0 on success, non-zero on failure
+     */
+    nsapi_error_t sync_dir(const char *local_dir, const char *remote_dir, SyncPolicy policy = SYNC_POLICY_SIZE, sync_summary_t *summary = nullptr);
 
 private:
+    /**
+     * Data writer implementation for put commands.
+     *
+     * @param path
+     * @param data_writer
+     * @return
+     */
+    nsapi_error_t _put_impl(const char *path, Callback<ssize_t(uint8_t *data, size_t size)> data_writer);
+
     /**
      * Data reader implementation for get/listdir commands.
      *
      * @param path
      * @param data_reader
      * @param command
+     * @param offset start file position (GET command only)
      * @return
      */
-    nsapi_error_t _get_data_impl(const char *path, Callback<ssize_t(uint8_t *data, size_t size)> data_reader, const char *command);
+    nsapi_error_t _get_data_impl(const char *path, Callback<ssize_t(uint8_t *data, size_t size)> data_reader, const char *command, long offset = 0);
 };
 }
 
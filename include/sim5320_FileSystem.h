@@ -0,0 +1,146 @@
+#ifndef SIM5320_FILESYSTEM_H
+#define SIM5320_FILESYSTEM_H
+
+#include "mbed.h"
+#include "mbed_chrono.h"
+
+#include "ATHandler.h"
+#include "FileSystem.h"
+
+#include "sim5320_FTPClient.h"
+
+namespace sim5320 {
+
+/**
+ * File system that is stored in the SIM5320 storage (internal flash or memory card).
+ *
+ * The files are accessed with "AT+FS*" and "AT+CFTRANRX"/"AT+CFTRANTX" commands, so to reduce number of AT transactions:
+ *
+ * - reads are done by blocks of the `sim5320-driver.fs_read_block_size` size; the last block is kept in a read-ahead cache;
+ * - writes are collected in a write-back buffer and passed to device by ::file_sync or ::file_close.
+ *
+ * The device cannot append data to an existing file, so it's rewritten completely on synchronization.
+ * As result a file that is opened for writing is kept in the RAM, and its size is limited by
+ * `sim5320-driver.fs_max_write_file_size` option. Large files should be transferred with ::ftp_download/::ftp_upload.
+ *
+ * The device doesn't allow to create empty files, so an empty file is represented by its absence:
+ * a file that is truncated to zero size is deleted, and a new empty file isn't created.
+ *
+ * Usage example:
+ *
+ * @code
+ * SIM5320FileSystem modem_fs(*modem_at, "modem");
+ * modem_fs.mount(nullptr);
+ * FILE *f = fopen("/modem/data.txt", "w");
+ * ...
+ * @endcode
+ */
+class SIM5320FileSystem : public FileSystem, private NonCopyable<SIM5320FileSystem> {
+public:
+    /**
+     * Constructor.
+     *
+     * @param at @c ATHandler object
+     * @param name file system name that is used as mount point
+     * @param modem_dir root directory of the file system in the device storage
+     */
+    SIM5320FileSystem(ATHandler &at, const char *name = nullptr, SIM5320FTPClient::ModemDir modem_dir = SIM5320FTPClient::MODEM_DIR_C);
+    virtual ~SIM5320FileSystem();
+
+    /**
+     * Mount file system.
+     *
+     * @param bd ignored, as device storage is used. It can be @c nullptr.
+     * @return 0 on success or negative error code
+     */
+    virtual int mount(BlockDevice *bd) override;
+
+    /**
+     * Unmount file system.
+     *
+     * @return 0 on success or negative error code
+     */
+    virtual int unmount() override;
+
+    virtual int remove(const char *path) override;
+    virtual int rename(const char *path, const char *newpath) override;
+    virtual int stat(const char *path, struct stat *st) override;
+    virtual int mkdir(const char *path, mode_t mode) override;
+    virtual int statvfs(const char *path, struct statvfs *buf) override;
+
+    /**
+     * Download file from ftp server into file system root directory.
+     *
+     * The file is transferred by device itself without MCU RAM usage, and it's saved with the
+     * same name as remote one (see SIM5320FTPClient::fetch_to_modem).
+     *
+     * @param ftp_client connected ftp client
+     * @param remote_path ftp file path
+     * @param timeout maximal transfer time
+     * @return 0 on success or negative error code
+     */
+    int ftp_download(SIM5320FTPClient *ftp_client, const char *remote_path, mbed::chrono::milliseconds_u32 timeout = FTP_TRANSFER_TIMEOUT);
+
+    /**
+     * Upload file from file system root directory to ftp server.
+     *
+     * The local file should have the same name as remote one (see SIM5320FTPClient::push_from_modem).
+     *
+     * @param ftp_client connected ftp client
+     * @param remote_path ftp file path
+     * @param timeout maximal transfer time
+     * @return 0 on success or negative error code
+     */
+    int ftp_upload(SIM5320FTPClient *ftp_client, const char *remote_path, mbed::chrono::milliseconds_u32 timeout = FTP_TRANSFER_TIMEOUT);
+
+    static constexpr mbed::chrono::milliseconds_u32 FTP_TRANSFER_TIMEOUT = 300s;
+
+protected:
+    virtual int file_open(fs_file_t *file, const char *path, int flags) override;
+    virtual int file_close(fs_file_t file) override;
+    virtual ssize_t file_read(fs_file_t file, void *buffer, size_t size) override;
+    virtual ssize_t file_write(fs_file_t file, const void *buffer, size_t size) override;
+    virtual int file_sync(fs_file_t file) override;
+    virtual off_t file_seek(fs_file_t file, off_t offset, int whence) override;
+    virtual off_t file_tell(fs_file_t file) override;
+    virtual off_t file_size(fs_file_t file) override;
+    virtual int file_truncate(fs_file_t file, off_t length) override;
+
+    virtual int dir_open(fs_dir_t *dir, const char *path) override;
+    virtual int dir_close(fs_dir_t dir) override;
+    virtual ssize_t dir_read(fs_dir_t dir, struct dirent *ent) override;
+    virtual void dir_seek(fs_dir_t dir, off_t offset) override;
+    virtual off_t dir_tell(fs_dir_t dir) override;
+    virtual void dir_rewind(fs_dir_t dir) override;
+    virtual size_t dir_size(fs_dir_t dir) override;
+
+private:
+    static const size_t READ_BLOCK_SIZE = MBED_CONF_SIM5320_DRIVER_FS_READ_BLOCK_SIZE;
+    static const size_t MAX_WRITE_FILE_SIZE = MBED_CONF_SIM5320_DRIVER_FS_MAX_WRITE_FILE_SIZE;
+    static const size_t PATH_MAX_LEN = 128;
+    friend struct fs_file_state_t;
+
+    ATHandler &_at;
+    SIM5320FTPClient::ModemDir _modem_dir;
+    bool _mounted;
+    Mutex _mutex;
+
+    // read-ahead cache of the last read block
+    uint8_t _cache_buf[READ_BLOCK_SIZE];
+    char _cache_path[PATH_MAX_LEN];
+    off_t _cache_offset;
+    size_t _cache_len;
+    bool _cache_valid;
+
+    int _build_modem_path(char *modem_path, const char *path);
+    void _invalidate_cache();
+    bool _is_cached(const char *modem_path);
+
+    int _read_attributes(const char *modem_path, off_t &size);
+    int _change_dir(const char *modem_path);
+    int _read_block(const char *modem_path, off_t offset, uint8_t *buf, size_t size);
+    int _write_file(const char *modem_path, const uint8_t *data, size_t size);
+};
+}
+
+#endif // SIM5320_FILESYSTEM_H
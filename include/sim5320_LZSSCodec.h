@@ -0,0 +1,138 @@
+#ifndef SIM5320_LZSSCODEC_H
+#define SIM5320_LZSSCODEC_H
+
+#include "mbed.h"
+
+namespace sim5320 {
+
+/**
+ * Streaming LZSS codec that is used to compress FTP transfers.
+ *
+ * Stream format:
+ *
+ * - data consists of groups; each group starts with a flag byte that is followed by up to 8 items;
+ * - bit `i` of the flag byte describes item `i`: `1` - literal byte, `0` - 2 byte reference;
+ * - reference bytes `b0 b1` encode offset `((b0 << 4) | (b1 >> 4)) + 1` (1 - 4096) to previous data
+ *   and length `(b1 & 0x0F) + 3` (3 - 18) of the repeated data;
+ * - the last group can contain less than 8 items.
+ *
+ * The codecs don't use dynamic memory allocation. The window size is set by `sim5320-driver.ftp_compression_window_size`
+ * option and decoder window should be not less than encoder one.
+ */
+class LZSSCodec {
+public:
+    static const size_t WINDOW_SIZE = MBED_CONF_SIM5320_DRIVER_FTP_COMPRESSION_WINDOW_SIZE;
+    static const size_t MIN_MATCH = 3;
+    static const size_t MAX_MATCH = 18;
+    static const size_t MAX_OFFSET = 4096;
+};
+
+/**
+ * Streaming LZSS encoder.
+ *
+ * It reads source data from a callback and returns compressed data by demand.
+ */
+class LZSSEncoder : public LZSSCodec, private NonCopyable<LZSSEncoder> {
+public:
+    LZSSEncoder();
+    virtual ~LZSSEncoder();
+
+    /**
+     * Start new stream.
+     *
+     * @param source source data callback. It has the same semantic as ::SIM5320FTPClient::put callback.
+     */
+    void start(Callback<ssize_t(uint8_t *data, size_t size)> source);
+
+    /**
+     * Read compressed data.
+     *
+     * @param data output buffer
+     * @param size buffer size
+     * @return number of the written bytes, 0 if stream is finished or negative error code
+     */
+    ssize_t read(uint8_t *data, size_t size);
+
+private:
+    static const size_t BUF_SIZE = 2 * WINDOW_SIZE;
+    static const size_t HASH_SIZE = 256;
+    static const int MAX_CHAIN_DEPTH = 16;
+
+    Callback<ssize_t(uint8_t *data, size_t size)> _source;
+    int _source_error;
+    bool _source_eof;
+
+    // source data: history window and lookahead
+    uint8_t _buf[BUF_SIZE];
+    // stream position of the _buf[0]
+    uint32_t _buf_base;
+    size_t _pos;
+    size_t _end;
+
+    // hash chains of the stream positions (lower 16 bits)
+    uint16_t _head[HASH_SIZE];
+    uint16_t _prev[WINDOW_SIZE];
+
+    // current output group
+    uint8_t _group[1 + 8 * 2];
+    size_t _group_len;
+    size_t _group_pos;
+
+    int _fill();
+    void _insert_hash(size_t pos);
+    size_t _find_match(size_t &distance);
+    int _encode_group();
+};
+
+/**
+ * Streaming LZSS decoder.
+ *
+ * It accepts compressed data and passes decompressed data to a callback.
+ */
+class LZSSDecoder : public LZSSCodec, private NonCopyable<LZSSDecoder> {
+public:
+    LZSSDecoder();
+    virtual ~LZSSDecoder();
+
+    /**
+     * Start new stream.
+     *
+     * @param sink decompressed data callback. It has the same semantic as ::SIM5320FTPClient::get callback.
+     */
+    void start(Callback<ssize_t(uint8_t *data, size_t size)> sink);
+
+    /**
+     * Decompress data block.
+     *
+     * @param data compressed data
+     * @param size data size
+     * @return @p size on success or negative error code
+     */
+    ssize_t write(uint8_t *data, size_t size);
+
+    /**
+     * Finish stream.
+     *
+     * @return 0 on success or negative error code if stream is truncated
+     */
+    int finish();
+
+private:
+    Callback<ssize_t(uint8_t *data, size_t size)> _sink;
+
+    uint8_t _window[WINDOW_SIZE];
+    // total number of the decoded and flushed bytes
+    uint32_t _decoded;
+    uint32_t _flushed;
+
+    uint8_t _flags;
+    uint8_t _items_left;
+    uint8_t _ref_byte;
+    bool _has_ref_byte;
+
+    int _put(uint8_t value);
+    int _flush();
+};
+}
+
+#endif // SIM5320_LZSSCODEC_H
@@ -6,6 +6,8 @@
 
 #include "ATHandler.h"
 
+#include "sim5320_SettingsCache.h"
+
 namespace sim5320 {
 
 #ifdef DEVICE_LPTICKER
@@ -14,6 +16,8 @@ using TargetTimer = LowPowerTimer;
 using TargetTimer = Timer;
 #endif
 
+struct gps_locate_async_ctx_t;
+
 /**
  * Location API of the SIM5320.
  *
@@ -26,6 +30,7 @@ protected:
     TargetTimer _up_timer;
 
     ATHandler &_at;
+    SIM5320SettingsCache *_settings_cache;
 
 private:
     /**
@@ -35,11 +40,8 @@ private:
      */
     void _cgpsftm_urc();
 
-    mbed::chrono::milliseconds_u32 _last_cgpsftm_urc_timestamp;
-    int _last_cgpsftm_urc_sats;
-
 public:
-    SIM5320LocationService(ATHandler &at);
+    SIM5320LocationService(ATHandler &at, SIM5320SettingsCache *settings_cache = nullptr);
     virtual ~SIM5320LocationService();
 
     /**
@@ -59,8 +61,57 @@ public:
         float altitude;
         /** current time */
         time_t time;
+        /** milliseconds part of the current time */
+        int time_ms;
+        /** speed over ground in m/s */
+        float speed;
+        /** course over ground in degrees */
+        float course;
+    };
+
+    /**
+     * Coordinates in the fixed point format.
+     *
+     * They are parsed without float point operations. Latitude and longitude are rounded to 1e-7 degrees (about 1 cm),
+     * that is slightly coarser than the device "ddmm.mmmmmm" resolution, but doesn't lose precision as float numbers do.
+     */
+    struct coord_fixed_t {
+        /** current longitude in 1e-7 degrees */
+        int32_t longitude;
+        /** current latitude in 1e-7 degrees */
+        int32_t latitude;
+        /** current altitude in centimeters */
+        int32_t altitude;
+        /** current time */
+        time_t time;
+        /** milliseconds part of the current time */
+        int time_ms;
+        /** speed over ground in cm/s */
+        int32_t speed;
+        /** course over ground in 1e-2 degrees */
+        int32_t course;
     };
 
+    /**
+     * Convert fixed point coordinates to float point ones.
+     *
+     * @param fixed_coord fixed point coordinates
+     * @param coord float point coordinates
+     */
+    static void convert_coord(const coord_fixed_t &fixed_coord, coord_t *coord);
+
+    /**
+     * Parse "+CGPSINFO: " response parameters.
+     *
+     * Example: "3113.343286,N,12121.234064,E,250311,072809.3,44.1,0.0,0".
+     *
+     * @param info response parameters without "+CGPSINFO: " prefix
+     * @param coord fixed point coordinates
+     * @param ff_flag it's set to @c true if @p info contains coordinates, otherwise @c false
+     * @return 0 on success, non-zero value if @p info has invalid format
+     */
+    static int parse_cgpsinfo(const char *info, coord_fixed_t *coord, bool &ff_flag);
+
     /**
      * Base station information.
      */
@@ -83,6 +134,70 @@ public:
         int network_type;
     };
 
+    /**
+     * Location source.
+     */
+    enum LocationSource {
+        /** Location isn't available */
+        LOCATION_SOURCE_NONE = 0,
+        /** GPS fix */
+        LOCATION_SOURCE_GPS = 1,
+        /** Cellular base station estimation */
+        LOCATION_SOURCE_CELL = 2
+    };
+
+    /**
+     * Cached location with metadata.
+     */
+    struct location_t {
+        /** coordinates */
+        coord_fixed_t coord;
+        /** coordinates source */
+        LocationSource source;
+        /** estimated horizontal accuracy in meters */
+        int accuracy;
+        /** time when location has been received */
+        Kernel::Clock::time_point timestamp;
+    };
+
+    /**
+     * Maximal number of the satellites in the ::gps_signal_info_t.
+     */
+    static const int GPS_MAX_SATELLITES = 16;
+
+    /**
+     * SNR threshold of the satellites that are good enough to get a fix.
+     */
+    static const int GPS_GOOD_SNR = 28;
+
+    /**
+     * Satellite signal information.
+     */
+    struct gps_satellite_t {
+        /** satellite number */
+        int prn;
+        /** signal to noise ratio (dB-Hz) or 0 if satellite isn't tracked */
+        int snr;
+    };
+
+    /**
+     * GPS signal information.
+     */
+    struct gps_signal_info_t {
+        /** time since GPS startup of the report */
+        mbed::chrono::milliseconds_u32 timestamp;
+        /** total number of the satellites in view */
+        int sats_in_view;
+        /** number of the satellites with SNR that isn't less than ::GPS_GOOD_SNR */
+        int good_sats;
+        /** maximal SNR */
+        int max_snr;
+        /** sum of the 4 best SNR values */
+        int score;
+        /** satellites (up to ::GPS_MAX_SATELLITES) */
+        gps_satellite_t sats[GPS_MAX_SATELLITES];
+    };
+
     /**
      * The GPS mode.
      */
@@ -137,6 +252,8 @@ private:
     {
         return _wait_gps_start_stop(false, timeout, check_period);
     }
+    // send GPS start command without waiting of the GPS startup
+    nsapi_error_t _gps_start_cmd(GPSMode mode, GPSStartupMode startup_mode);
 
 public:
     /**
@@ -162,6 +279,110 @@ public:
      */
     nsapi_error_t gps_read_coord(coord_t *coord, bool &ff_flag);
 
+    /**
+     * Read current GPS coordinates in the fixed point format.
+     *
+     * See ::gps_read_coord.
+     *
+     * @param coord gps coordinates
+     * @param ff_flag first fix flag
+     * @return 0 on success, non-zero on failure
+     */
+    nsapi_error_t gps_read_coord(coord_fixed_t *coord, bool &ff_flag);
+
+private:
+    // last satellite report of the CGPSFTM URC codes
+    gps_signal_info_t _signal_info;
+
+public:
+    /**
+     * Enable/disable satellite signal reports (see AT+CGPSFTM).
+     *
+     * If reports are enabled, the device sends SNR of the satellites in view every second,
+     * and they can be read with ::gps_get_signal_info. The ::gps_locate enables reports automatically.
+     *
+     * @param enabled
+     * @return 0 on success, non-zero on failure
+     */
+    nsapi_error_t gps_set_signal_monitoring(bool enabled);
+
+    /**
+     * Get last satellite signal report.
+     *
+     * The method doesn't use AT commands, so URC codes should be processed by URC dispatcher
+     * (see sim5320::SIM5320::start_urc_dispatcher) or other AT commands.
+     *
+     * @param info signal information
+     */
+    void gps_get_signal_info(gps_signal_info_t *info);
+
+private:
+    static constexpr std::chrono::seconds _GPS_STREAM_MAX_PERIOD = 255s;
+
+    // latest value slot of the streaming mode and its fix number, that are protected by critical section
+    uint32_t _stream_seq;
+    coord_fixed_t _stream_coord;
+    Callback<void(const coord_t &coord)> _stream_cb;
+
+    /**
+     * Read "+CGPSINFO: " parameters.
+     */
+    void _read_cgpsinfo_params(coord_fixed_t *coord, bool &ff_flag);
+
+    /**
+     * Periodic "+CGPSINFO: " URC code processing.
+     */
+    void _cgpsinfo_urc();
+
+public:
+    /**
+     * Start position streaming.
+     *
+     * The device reports current position by URC codes with a given period, so the fixes can be received without AT commands.
+     * The URC codes are processed only with AT commands, so use URC dispatcher (see sim5320::SIM5320::start_urc_dispatcher)
+     * to get timely updates.
+     *
+     * The last fix is stored into a slot that can be read by ::gps_stream_read.
+     *
+     * @note
+     * GPS should be started with ::gps_start before streaming.
+     *
+     * @param period position report period (1 - 255 seconds)
+     * @param fix_cb optional callback that is invoked for each fix. It's invoked from URC context, so it shouldn't use AT commands.
+     * @return 0 on success, non-zero on failure
+     */
+    nsapi_error_t gps_stream_start(std::chrono::seconds period = 1s, Callback<void(const coord_t &coord)> fix_cb = nullptr);
+
+    /**
+     * Stop position streaming.
+     *
+     * @return 0 on success, non-zero on failure
+     */
+    nsapi_error_t gps_stream_stop();
+
+    /**
+     * Read the last streamed position.
+     *
+     * The method doesn't use AT commands and mutexes, and the slot is copied in a short critical section,
+     * so it can be invoked from any context including ISR.
+     *
+     * @param coord gps coordinates
+     * @param fix_number optional number of the fix that can be used to detect new positions
+     * @return @c true if any fix has been received, otherwise @c false
+     */
+    bool gps_stream_read(coord_t *coord, uint32_t *fix_number = nullptr);
+
+    /**
+     * Read the last streamed position in the fixed point format.
+     *
+     * See ::gps_stream_read.
+     *
+     * @param coord gps coordinates
+     * @param fix_number optional number of the fix
+     * @return @c true if any fix has been received, otherwise @c false
+     */
+    bool gps_stream_read(coord_fixed_t *coord, uint32_t *fix_number = nullptr);
+
 private:
     int _gps_stop_internal(mbed::chrono::milliseconds_u32 &op_duration);
 
@@ -177,7 +398,7 @@ private:
     /**
      * Run GPS with current settings, try to get coordinates and stop.
      */
-    nsapi_error_t _gps_locate_base_impl(coord_t *coord, bool &ff_flag, GPSMode mode, GPSStartupMode startup_mode, Callback<mbed::chrono::milliseconds_u32(int)> timeout_cb, mbed::chrono::milliseconds_u32 poll_period);
+    nsapi_error_t _gps_locate_base_impl(coord_t *coord, bool &ff_flag, GPSMode mode, GPSStartupMode startup_mode, Callback<bool(const gps_signal_info_t &info, mbed::chrono::milliseconds_u32 elapsed_time)> continue_cb, mbed::chrono::milliseconds_u32 poll_period);
 
 public:
     /**
@@ -196,13 +417,74 @@ public:
      */
     nsapi_error_t gps_locate(coord_t *coord, bool &ff_flag, GPSMode mode = GPS_MODE_STANDALONE);
 
+private:
+    // state of the asynchronous location resolving
+    gps_locate_async_ctx_t *_async_ctx;
+    // number of the started operations, that is used to ignore events of the cancelled ones
+    uint32_t _async_generation;
+    // number of the dispatched events of the cancelled operations that haven't completed yet
+    int _async_orphan_steps;
+    Mutex _async_mutex;
+
+    void _gps_locate_async_step(uint32_t generation);
+
+public:
+    /**
+     * Locate current coordinates asynchronously.
+     *
+     * It has the same logic as ::gps_locate, but GPS startup, polling, stopping and retries are run as
+     * events of the @p queue, so the caller thread isn't blocked. The ATHandler is locked only during
+     * each step, so other AT commands can be used between them.
+     *
+     * Each step waits @c ATHandler lock and can take some seconds, so @p queue shouldn't be used for time
+     * critical events (the mbed shared event queue isn't recommended).
+     *
+     * The @p done_cb is invoked from the @p queue context. If the coordinates aren't resolved,
+     * it gets non-zero error (@c NSAPI_ERROR_TIMEOUT if device hasn't got a fix).
+     *
+     * Only one operation can be run at the same time.
+     *
+     * @param queue event queue to run the operation
+     * @param done_cb completion callback
+     * @param mode GPS mode
+     * @return 0 if the operation has been started, non-zero on failure (@c NSAPI_ERROR_BUSY if another one is running,
+     *         @c NSAPI_ERROR_PARAMETER if @p queue isn't set)
+     */
+    nsapi_error_t gps_locate_async(EventQueue *queue, Callback<void(nsapi_error_t err, const coord_t &coord)> done_cb, GPSMode mode = GPS_MODE_STANDALONE);
+
+    /**
+     * Cancel asynchronous location resolving.
+     *
+     * The GPS is stopped if it has been started by operation. The completion callback isn't invoked.
+     *
+     * @note
+     * The method shouldn't be invoked from the event queue of the operation if GPS can be active,
+     * as GPS stopping blocks it for some seconds.
+     *
+     * The object destructor cancels the operation and waits completion of its already dispatched step,
+     * so the object shouldn't be deleted from the event queue of the operation while it's running.
+     *
+     * @return 0 on success, non-zero on failure
+     */
+    nsapi_error_t gps_locate_cancel();
+
+    /**
+     * Check if asynchronous location resolving is run.
+     *
+     * @return @c true if operation is run, otherwise @c false
+     */
+    bool gps_locate_is_running();
+
     /**
      * Check if GPS is run.
      *
+     * The state is cached by driver, so AT command is sent only if it's unknown or @p force_refresh is set.
+     *
      * @param flag @c true if GPS is run, otherwise @c false
+     * @param force_refresh read state from device
      * @return 0 on success, non-zero on failure
      */
-    nsapi_error_t gps_is_active(bool &flag);
+    nsapi_error_t gps_is_active(bool &flag, bool force_refresh = false);
 
     /**
      * Clear stored almanac and ephemeris data.
@@ -280,6 +562,62 @@ public:
      * @return 0 on success, non-zero on failure
      */
     nsapi_error_t cell_system_read_info(station_info_t *station_info, bool &has_data);
+
+private:
+    // device default of the AT+CGPSHOR
+    static const int _GPS_DEFAULT_ACCURACY = 50;
+
+    // last known location
+    location_t _last_location;
+    // desired GPS accuracy that is used as estimation of the fix accuracy
+    int _gps_accuracy;
+
+    void _update_last_location(const coord_fixed_t &coord, LocationSource source, int accuracy);
+
+public:
+    /**
+     * Get the last known location.
+     *
+     * The location is updated by any successful coordinates reading (::gps_read_coord, ::gps_locate,
+     * ::gps_locate_async, position streaming) and ::set_last_location, so it can be shared between
+     * application modules without redundant GPS startups.
+     *
+     * The method doesn't use AT commands, so it can be invoked from any thread.
+     *
+     * @param location last location
+     * @param max_age maximal age of the location
+     * @return @c true if location that isn't older than @p max_age is available, otherwise @c false
+     */
+    bool get_last_location(location_t *location, mbed::chrono::milliseconds_u32 max_age);
+
+    /**
+     * Get the last known location in the float point format.
+     *
+     * See ::get_last_location.
+     *
+     * @param coord last coordinates
+     * @param max_age maximal age of the location
+     * @return @c true if location that isn't older than @p max_age is available, otherwise @c false
+     */
+    bool get_last_location(coord_t *coord, mbed::chrono::milliseconds_u32 max_age);
+
+    /**
+     * Update the last known location with coordinates from other source.
+     *
+     * It can be used to save location that is estimated by cellular base station information (see ::cell_system_read_info).
+     * The location isn't updated if there is a GPS fix that is more accurate and isn't older than @p max_gps_age.
+     *
+     * @param coord coordinates
+     * @param source coordinates source
+     * @param accuracy estimated horizontal accuracy in meters
+     * @param max_gps_age time during which GPS fix has priority over less accurate locations
+     */
+    void set_last_location(const coord_fixed_t &coord, LocationSource source, int accuracy, mbed::chrono::milliseconds_u32 max_gps_age = 0s);
+
+    /**
+     * Reset the last known location.
+     */
+    void clear_last_location();
 };
 }
 
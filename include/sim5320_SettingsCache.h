@@ -0,0 +1,175 @@
+#ifndef SIM5320_SETTINGSCACHE_H
+#define SIM5320_SETTINGSCACHE_H
+
+#include "mbed.h"
+
+#include "ATHandler.h"
+
+namespace sim5320 {
+
+/**
+ * Shadow copy of the device settings that have been written by the driver.
+ *
+ * It's used to skip AT commands that write settings, if device already has target values.
+ * The cache should be invalidated, when device can lose its settings (reset, factory settings restoring).
+ * The settings are kept across power level changes, so network reconnection doesn't rewrite them.
+ *
+ * Additionally it keeps device states (power level, network attach, GPS state) that are updated by driver
+ * commands and URC codes, so frequent state requests don't require AT commands. The states are invalidated
+ * on power level change.
+ */
+class SIM5320SettingsCache : private NonCopyable<SIM5320SettingsCache> {
+public:
+    SIM5320SettingsCache();
+    virtual ~SIM5320SettingsCache();
+
+    /**
+     * Cached settings.
+     */
+    enum Setting {
+        /** PDP context parameters (hash of the APN) */
+        CGDCONT = 0,
+        /** PDP context for sockets */
+        CSOCKSETPN,
+        /** preferred radio access technology */
+        CNMP,
+        /** remote IP prompt of the received data */
+        CIPSRIP,
+        /** TCP/IP application mode */
+        CIPMODE,
+        /** manual data receive mode */
+        CIPRXGET,
+        /** TCP/IP parameters */
+        CIPCCFG,
+        /** automatic time and time zone update */
+        CTZU,
+        /** automatic GPS start */
+        CGPSAUTO,
+        /** GPS position mode */
+        CGPSPMD,
+        /** time servers (hash of the server list) */
+        CHTPSERV,
+        // note: the items below are device states
+        /** device power level */
+        CFUN,
+        /** network attach state */
+        CGATT,
+        /** GPS state */
+        CGPS,
+        SETTING_MAX
+    };
+
+    /**
+     * Enable/disable cache.
+     *
+     * If cache is disabled, all settings are considered unknown, so they are always written.
+     *
+     * @param enabled
+     */
+    void set_enabled(bool enabled);
+
+    /**
+     * Check if the device setting has given value.
+     *
+     * @param setting setting id
+     * @param value expected value
+     * @return @c true if setting has been written with the same value, otherwise @c false
+     */
+    bool is_set(Setting setting, uint32_t value) const;
+
+    /**
+     * Get cached setting value.
+     *
+     * @param setting setting id
+     * @param value cached value
+     * @return @c true if value is known, otherwise @c false
+     */
+    bool get(Setting setting, uint32_t &value) const;
+
+    /**
+     * Remember value that has been written to the device.
+     *
+     * @param setting setting id
+     * @param value written value
+     */
+    void set(Setting setting, uint32_t value);
+
+    /**
+     * Forget a setting value.
+     *
+     * @param setting setting id
+     */
+    void invalidate(Setting setting);
+
+    /**
+     * Forget all settings and states.
+     */
+    void invalidate();
+
+    /**
+     * Forget device states (power level, network attach, GPS state), but keep settings.
+     */
+    void invalidate_states();
+
+    /**
+     * Update device power level.
+     *
+     * If power level is changed, other device states are invalidated.
+     *
+     * @param func_level power level (see AT+CFUN)
+     */
+    void update_power_level(int func_level);
+
+    /**
+     * Helper function to write integer setting ("AT<cmd>=<value>"), if it differs from cached value.
+     *
+     * @param at @c ATHandler object
+     * @param setting setting id
+     * @param cmd command without "AT" prefix
+     * @param value target value
+     * @param lock ATHandler lock flag
+     * @return 0 on success, otherwise non-zero value
+     */
+    nsapi_error_t write_i(ATHandler &at, Setting setting, const char *cmd, int value, bool lock = true);
+
+    /**
+     * Read all cached integer settings with one AT command and invalidate values that differ from device ones.
+     *
+     * The string settings (PDP context, time servers) cannot be verified this way, so they are kept as is.
+     *
+     * @param at @c ATHandler object
+     * @return 0 on success, otherwise non-zero value
+     */
+    nsapi_error_t verify(ATHandler &at);
+
+    /**
+     * Calculate string hash to store string settings.
+     *
+     * @param str string
+     * @param hash previous hash value to calculate hash of several strings
+     * @return hash value
+     */
+    static uint32_t hash(const char *str, uint32_t hash = HASH_INIT);
+
+    static const uint32_t HASH_INIT = 2166136261u;
+
+    /**
+     * Get number of the settings that have been written to the device and remembered by cache.
+     *
+     * Device states aren't counted. It can be used to check that cache skips repeated writes.
+     *
+     * @return number of the settings writes
+     */
+    uint32_t get_write_count() const;
+
+private:
+    static const uint32_t STATES_MASK = (1u << CFUN) | (1u << CGATT) | (1u << CGPS);
+
+    uint32_t _values[SETTING_MAX];
+    uint32_t _valid_mask;
+    uint32_t _write_count;
+    bool _enabled;
+};
+}
+
+#endif // SIM5320_SETTINGSCACHE_H
@@ -5,6 +5,8 @@
 
 #include "ATHandler.h"
 
+#include "sim5320_SettingsCache.h"
+
 namespace sim5320 {
 
 /**
@@ -13,15 +15,17 @@ namespace sim5320 {
 class SIM5320TimeService : private NonCopyable<SIM5320TimeService> {
 protected:
     ATHandler &_at;
+    SIM5320SettingsCache *_settings_cache;
 
 public:
-    SIM5320TimeService(ATHandler &at);
+    SIM5320TimeService(ATHandler &at, SIM5320SettingsCache *settings_cache = nullptr);
     virtual ~SIM5320TimeService();
 
 private:
     const char *const *_htp_servers;
     size_t _htp_servers_num;
 
+    nsapi_error_t _write_htp_servers(const char *const servers[], size_t size);
     nsapi_error_t _sync_time_with_htp_servers(const char *const servers[], size_t size);
 
     nsapi_error_t _read_modem_clk(time_t *time);
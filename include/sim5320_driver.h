@@ -135,6 +135,31 @@ public:
      */
     nsapi_error_t process_urc();
 
+    /**
+     * Start background URC processing.
+     *
+     * When serial interface gets new data, the ATHandler posts OOB processing event into the cellular device event queue.
+     * This method attaches this queue to the @p queue, so URC codes (incoming socket data, closed connections, SMS and so on)
+     * are processed as soon as they arrive, and there is no need to poll ::process_urc.
+     *
+     * If @p queue is @c nullptr, then the driver starts own thread with a stack of the
+     * `sim5320-driver.urc_dispatcher_stack_size` size to process events.
+     *
+     * @note
+     * The URC handlers and socket callbacks will be invoked from the dispatcher context.
+     *
+     * @param queue user event queue or @c nullptr to use driver thread
+     * @return 0 on success, @c NSAPI_ERROR_ALREADY if dispatcher is already started or other non-zero code on failure
+     */
+    nsapi_error_t start_urc_dispatcher(EventQueue *queue = nullptr);
+
+    /**
+     * Stop background URC processing.
+     *
+     * @return 0 on success, non-zero on failure
+     */
+    nsapi_error_t stop_urc_dispatcher();
+
     enum ResetMode {
         RESET_MODE_DEFAULT = 0,
         RESET_MODE_SOFT = 1,
@@ -149,12 +174,28 @@ public:
      */
     nsapi_error_t reset(ResetMode reset_mode = RESET_MODE_DEFAULT);
 
+    /**
+     * Enable/disable fast boot mode.
+     *
+     * By default, after device reset the driver waits "START" and "PB DONE" messages, that can take up to 48 seconds.
+     * In the fast boot mode the driver continues right after "START" message (the AT interface is checked only if it's missed).
+     * The phonebook initialization is tracked separately, and only operations that require it
+     * (SMS, subscriber number) wait it.
+     *
+     * @param enabled fast boot mode flag
+     */
+    void set_fast_boot(bool enabled);
+
     /**
      * Check if module is run.
      *
+     * The state is cached by driver, so AT command is sent only if it's unknown or @p force_refresh is set.
+     *
+     * @param active
+     * @param force_refresh read state from device
      * @return 0 on success, non-zero on failure
      */
-    nsapi_error_t is_active(bool &active);
+    nsapi_error_t is_active(bool &active, bool force_refresh = false);
 
     /**
      * Get cellular device interface.
@@ -214,6 +255,13 @@ public:
      */
     SIM5320TimeService *get_time_service();
 
+    /**
+     * Get cache of the device settings.
+     *
+     * @return
+     */
+    SIM5320SettingsCache *get_settings_cache();
+
 private:
     PinName _rts;
     PinName _cts;
@@ -236,12 +284,19 @@ private:
 
     int _startup_request_count;
     int _network_up_request_count;
+    bool _fast_boot;
     ATHandler *_at;
 
+    EventQueue *_urc_dispatcher_queue;
+    EventQueue *_urc_dispatcher_own_queue;
+    Thread *_urc_dispatcher_thread;
+
     static constexpr mbed::chrono::milliseconds_u32 _STARTUP_TIMEOUT = 48s;
+    static constexpr mbed::chrono::milliseconds_u32 _FAST_BOOT_POLL_PERIOD = 500ms;
     nsapi_error_t _reset_soft();
     nsapi_error_t _reset_hard();
     nsapi_error_t _skip_initialization_messages();
+    nsapi_error_t _wait_at_interface();
 };
 }
 
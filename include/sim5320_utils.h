@@ -180,6 +180,19 @@ nsapi_error_t at_cmdw_set_ii(ATHandler &at, const char *cmd, int value_1, int va
  */
 nsapi_error_t at_cmdw_get_ii(ATHandler &at, const char *cmd, int &value_1, int &value_2, bool lock = true);
 
+/**
+ * Helper function to read a file block from the device storage with "AT+CFTRANTX" command.
+ *
+ * @param at @c ATHandler object
+ * @param modem_path full file path in the device storage ("C:/<name>")
+ * @param offset block offset
+ * @param buf output buffer
+ * @param size block size
+ * @param lock ATHandler lock flag
+ * @return number of the read bytes (it's less than @p size at the end of file), or negative error code
+ */
+ssize_t at_read_modem_file_block(ATHandler &at, const char *modem_path, long offset, uint8_t *buf, size_t size, bool lock = true);
+
 /**
  * Helper simplified string parser to parse complex strings that are returned by AT command reponces (like time or gps coordinates).
  *
@@ -221,6 +234,19 @@ public:
      */
     void reset_timeout();
 
+    /**
+     * Temporary release @c ATHandler lock.
+     *
+     * It allows other threads to use @c ATHandler during long operations. The original AT timeout is restored
+     * till ::lock invocation.
+     */
+    void unlock();
+
+    /**
+     * Acquire @c ATHandler lock again after ::unlock invocation.
+     */
+    void lock();
+
 private:
     ATHandler &_at;
     mbed::chrono::milliseconds_u32 _timeout;
@@ -34,21 +34,27 @@ void SIM5320CellularContext::do_connect()
     int err;
     Timer timer;
 
+    SIM5320SettingsCache *settings_cache = _sim5320_device->get_settings_cache();
+
     call_network_cb(NSAPI_STATUS_CONNECTING);
     if (!_is_context_active) {
         {
             // configure context
             ATHandlerLocker locker(_at);
             // set PDP context parameters
-            _at.cmd_start("AT+CGDCONT=");
-            _at.write_int(PDP_CONTEXT_ID);
-            _at.write_string("IP");
-            _at.write_string(_apn);
-            _at.cmd_stop_read_resp();
+            uint32_t apn_hash = SIM5320SettingsCache::hash(_apn);
+            if (!settings_cache->is_set(SIM5320SettingsCache::CGDCONT, apn_hash)) {
+                _at.cmd_start("AT+CGDCONT=");
+                _at.write_int(PDP_CONTEXT_ID);
+                _at.write_string("IP");
+                _at.write_string(_apn);
+                _at.cmd_stop_read_resp();
+                if (!_at.get_last_error()) {
+                    settings_cache->set(SIM5320SettingsCache::CGDCONT, apn_hash);
+                }
+            }
             // set PDP context for sockets
-            _at.cmd_start("AT+CSOCKSETPN=");
-            _at.write_int(PDP_CONTEXT_ID);
-            _at.cmd_stop_read_resp();
+            settings_cache->write_i(_at, SIM5320SettingsCache::CSOCKSETPN, "+CSOCKSETPN", PDP_CONTEXT_ID, false);
             _cid = PDP_CONTEXT_ID;
             // set user/password
             do_user_authentication();
@@ -68,23 +74,24 @@ void SIM5320CellularContext::do_connect()
     // activate network
     {
         // TCP/IP module to use command mode
+        // note: settings that device already has are skipped
         ATHandlerLocker locker(_at);
         // set automatic network type selection
-        _at.cmd_start("AT+CNMP=");
-        _at.write_int(2);
-        _at.cmd_stop_read_resp();
+        settings_cache->write_i(_at, SIM5320SettingsCache::CNMP, "+CNMP", 2, false);
         // don't show prompt with remove IP when new data is received
-        _at.cmd_start("AT+CIPSRIP=0");
-        _at.cmd_stop_read_resp();
+        settings_cache->write_i(_at, SIM5320SettingsCache::CIPSRIP, "+CIPSRIP", 0, false);
         // set command mode (non-transparent mode)
-        _at.cmd_start("AT+CIPMODE=0");
-        _at.cmd_stop_read_resp();
+        settings_cache->write_i(_at, SIM5320SettingsCache::CIPMODE, "+CIPMODE", 0, false);
         // set manual data receive mode
-        _at.cmd_start("AT+CIPRXGET=1");
-        _at.cmd_stop_read_resp();
+        settings_cache->write_i(_at, SIM5320SettingsCache::CIPRXGET, "+CIPRXGET", 1, false);
         // configure receive urc: "+RECEIVE"
-        _at.cmd_start("AT+CIPCCFG=,,,,1");
-        _at.cmd_stop_read_resp();
+        if (!settings_cache->is_set(SIM5320SettingsCache::CIPCCFG, 1)) {
+            _at.cmd_start("AT+CIPCCFG=,,,,1");
+            _at.cmd_stop_read_resp();
+            if (!_at.get_last_error()) {
+                settings_cache->set(SIM5320SettingsCache::CIPCCFG, 1);
+            }
+        }
         // activate PDP context
         _at.cmd_start("AT+NETOPEN");
         _at.cmd_stop_read_resp();
@@ -5,10 +5,12 @@
 #include "sim5320_CellularSMS.h"
 
 #include "AT_CellularNetwork.h"
+#include "mbed_chrono.h"
 
 #include "sim5320_trace.h"
 #include "sim5320_utils.h"
 
+using mbed::chrono::milliseconds_u32;
 using namespace sim5320;
 
 static const intptr_t cellular_properties[AT_CellularDevice::PROPERTY_MAX] = {
@@ -75,15 +77,22 @@ static const intptr_t cellular_properties[AT_CellularDevice::PROPERTY_MAX] = {
 
 SIM5320CellularDevice::SIM5320CellularDevice(FileHandle *fh)
     : AT_CellularDevice(fh)
+    , _phonebook_ready(true)
 {
     set_timeout(SIM5320_DEFAULT_TIMEOUT);
 
     MBED_STATIC_ASSERT(AT_CellularDevice::PROPERTY_MAX == 20, "Wrong number of cellular property. Please check and fix driver implementation");
     AT_CellularDevice::set_cellular_properties(cellular_properties);
+
+    _at.set_urc_handler("PB DONE", callback(this, &SIM5320CellularDevice::_urc_pb_done));
+    _at.set_urc_handler("START", callback(this, &SIM5320CellularDevice::_urc_start));
 }
 
 SIM5320CellularDevice::~SIM5320CellularDevice()
 {
+    _at.set_urc_handler("PB DONE", nullptr);
+    _at.set_urc_handler("START", nullptr);
+
     _location_service.cleanup(this);
     _ftp_client.cleanup(this);
     _time_service.cleanup(this);
@@ -128,12 +137,22 @@ nsapi_error_t SIM5320CellularDevice::set_power_level(int func_level)
     _at.cmd_start("AT+CFUN=");
     _at.write_int(func_level);
     _at.cmd_stop_read_resp();
+    if (!_at.get_last_error()) {
+        _settings_cache.update_power_level(func_level);
+    } else {
+        _settings_cache.invalidate_states();
+    }
     return _at.get_last_error();
 }
 
-nsapi_error_t SIM5320CellularDevice::get_power_level(int &func_level)
+nsapi_error_t SIM5320CellularDevice::get_power_level(int &func_level, bool force_refresh)
 {
     int result;
+    uint32_t cached_func_level;
+    if (!force_refresh && _settings_cache.get(SIM5320SettingsCache::CFUN, cached_func_level)) {
+        func_level = cached_func_level;
+        return NSAPI_ERROR_OK;
+    }
     ATHandlerLocker locker(_at);
     _at.cmd_start("AT+CFUN?");
     _at.cmd_stop();
@@ -142,6 +161,7 @@ nsapi_error_t SIM5320CellularDevice::get_power_level(int &func_level)
     _at.resp_stop();
     if (!_at.get_last_error()) {
         func_level = result;
+        _settings_cache.update_power_level(func_level);
     }
     return _at.get_last_error();
 }
@@ -157,9 +177,13 @@ void SIM5320CellularDevice::set_timeout(int timeout)
 nsapi_error_t SIM5320CellularDevice::init()
 {
     nsapi_error_t err;
-    if ((err = AT_CellularDevice::init())) {
+    // note: AT_CellularDevice::init switches device into full functionality mode
+    err = AT_CellularDevice::init();
+    if (err) {
+        _settings_cache.invalidate_states();
         return err;
     }
+    _settings_cache.update_power_level(1);
     // disable STK function
     ATHandlerLocker locker(_at);
     _at.cmd_start("AT+STK=0");
@@ -178,11 +202,28 @@ nsapi_error_t SIM5320CellularDevice::init()
     err = _at.get_last_error();
 
     // set automatic radio access technology selection
-    _at.at_cmd_discard("+CNMP", "=", "%i", 2);
+    _settings_cache.write_i(_at, SIM5320SettingsCache::CNMP, "+CNMP", 2, false);
 
     return err;
 }
 
+nsapi_error_t SIM5320CellularDevice::shutdown()
+{
+    // device can change power level during shutdown
+    _settings_cache.invalidate_states();
+    return AT_CellularDevice::shutdown();
+}
+
+SIM5320SettingsCache *SIM5320CellularDevice::get_settings_cache()
+{
+    return &_settings_cache;
+}
+
+nsapi_error_t SIM5320CellularDevice::verify_settings_cache()
+{
+    return _settings_cache.verify(_at);
+}
+
 SIM5320LocationService *SIM5320CellularDevice::open_location_service()
 {
     return _location_service.open_interface(this);
@@ -213,12 +254,71 @@ void SIM5320CellularDevice::close_time_service()
     _time_service.close_interface(this);
 }
 
+void SIM5320CellularDevice::_urc_pb_done()
+{
+    _phonebook_ready = true;
+}
+
+void SIM5320CellularDevice::_urc_start()
+{
+    // device has been restarted, so all settings and states are lost
+    tr_debug("sim5320: device startup message");
+    _settings_cache.invalidate();
+}
+
+void SIM5320CellularDevice::set_phonebook_ready(bool ready)
+{
+    _phonebook_ready = ready;
+    if (!ready) {
+        _phonebook_timer.reset();
+        _phonebook_timer.start();
+    }
+}
+
+static constexpr milliseconds_u32 PHONEBOOK_READY_TIMEOUT = 48s;
+static constexpr milliseconds_u32 PHONEBOOK_CHECK_PERIOD = 1s;
+
+nsapi_error_t SIM5320CellularDevice::wait_phonebook_ready()
+{
+    nsapi_error_t err = NSAPI_ERROR_OK;
+
+    while (!_phonebook_ready) {
+        {
+            ATHandlerLocker locker(_at);
+            // check if "PB DONE" message has been received
+            _at.process_oob();
+            if (_phonebook_ready) {
+                break;
+            }
+            // the message can be lost, so check phonebook directly, as it returns error till initialization end
+            err = _at.at_cmd_discard("+CPBS", "?");
+        }
+        if (!err) {
+            _phonebook_ready = true;
+            break;
+        }
+        if (_phonebook_timer.elapsed_time() > PHONEBOOK_READY_TIMEOUT) {
+            tr_warning("sim5320: phonebook isn't ready");
+            return NSAPI_ERROR_DEVICE_ERROR;
+        }
+        ThisThread::sleep_for(PHONEBOOK_CHECK_PERIOD);
+    }
+    _phonebook_timer.stop();
+
+    return NSAPI_ERROR_OK;
+}
+
 #define SUBSCRIBER_NUMBER_INDEX 1
 
 nsapi_error_t SIM5320CellularDevice::get_subscriber_number(char *number)
 {
     bool find_number = false;
     int number_type;
+    nsapi_error_t err;
+
+    if ((err = wait_phonebook_ready())) {
+        return err;
+    }
 
     ATHandlerLocker locker(_at);
     // active MSISDN memory
@@ -255,9 +355,14 @@ nsapi_error_t SIM5320CellularDevice::get_subscriber_number(char *number)
 
 nsapi_error_t SIM5320CellularDevice::set_subscriber_number(const char *number)
 {
+    nsapi_error_t err;
+
     if (number == NULL) {
         return NSAPI_ERROR_PARAMETER;
     }
+    if ((err = wait_phonebook_ready())) {
+        return err;
+    }
 
     ATHandlerLocker locker(_at);
 
@@ -312,13 +417,13 @@ SIM5320CellularInformation *SIM5320CellularDevice::open_information_base_impl(AT
 
 SIM5320CellularNetwork *SIM5320CellularDevice::open_network_base_impl(ATHandler &at)
 {
-    return new SIM5320CellularNetwork(at);
+    return new SIM5320CellularNetwork(at, &_settings_cache);
 }
 
 #if MBED_CONF_CELLULAR_USE_SMS
 SIM5320CellularSMS *SIM5320CellularDevice::open_sms_base_impl(ATHandler &at)
 {
-    return new SIM5320CellularSMS(at);
+    return new SIM5320CellularSMS(at, this);
 }
 #endif // MBED_CONF_CELLULAR_USE_SMS
 
@@ -329,7 +434,7 @@ AT_CellularContext *SIM5320CellularDevice::create_context_impl(ATHandler &at, co
 
 SIM5320LocationService *SIM5320CellularDevice::open_location_service_base_impl(ATHandler &at)
 {
-    return new SIM5320LocationService(at);
+    return new SIM5320LocationService(at, &_settings_cache);
 }
 
 SIM5320FTPClient *SIM5320CellularDevice::open_ftp_client_base_impl(ATHandler &at)
@@ -339,5 +444,5 @@ SIM5320FTPClient *SIM5320CellularDevice::open_ftp_client_base_impl(ATHandler &at
 
 SIM5320TimeService *SIM5320CellularDevice::open_time_service_base_impl(ATHandler &at)
 {
-    return new SIM5320TimeService(at);
+    return new SIM5320TimeService(at, &_settings_cache);
 }
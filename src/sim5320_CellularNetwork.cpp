@@ -29,6 +29,10 @@ void SIM5320CellularNetwork::_urc_cgreg()
 
 void SIM5320CellularNetwork::_urc_cgev()
 {
+    // network or device detach
+    if (_settings_cache) {
+        _settings_cache->set(SIM5320SettingsCache::CGATT, 0);
+    }
     if (_connection_status_cb) {
         _connection_status_cb(NSAPI_EVENT_CONNECTION_STATUS_CHANGE, NSAPI_STATUS_DISCONNECTED);
     }
@@ -78,6 +82,10 @@ nsapi_error_t SIM5320CellularNetwork::_read_and_process_reg_params(CellularNetwo
     // process registration status
     if (_reg_params._status != status || _reg_params._type != type) {
         RegistrationStatus previous_registration_status = _reg_params._status;
+        // attach state can be changed with registration status
+        if (_settings_cache && type == C_GREG) {
+            _settings_cache->invalidate(SIM5320SettingsCache::CGATT);
+        }
         _reg_params._status = status;
         _reg_params._type = type;
 
@@ -109,8 +117,9 @@ nsapi_error_t SIM5320CellularNetwork::_read_and_process_reg_params(CellularNetwo
     return NSAPI_ERROR_OK;
 }
 
-SIM5320CellularNetwork::SIM5320CellularNetwork(ATHandler &at_handler)
+SIM5320CellularNetwork::SIM5320CellularNetwork(ATHandler &at_handler, SIM5320SettingsCache *settings_cache)
     : _at(at_handler)
+    , _settings_cache(settings_cache)
     , _op_act(RAT_UNKNOWN)
     , _connect_status(NSAPI_STATUS_DISCONNECTED)
 {
@@ -188,21 +197,40 @@ nsapi_error_t SIM5320CellularNetwork::set_attach()
 {
     ATHandlerLocker locker(_at);
     AttachStatus status;
-    get_attach(status);
+    get_attach(status, true);
 
     if (status == Detached) {
         tr_debug("Network attach");
         _at.at_cmd_discard("+CGATT", "=1");
+        if (_settings_cache && !_at.get_last_error()) {
+            _settings_cache->set(SIM5320SettingsCache::CGATT, 1);
+        }
     }
 
     return _at.get_last_error();
 }
 
 nsapi_error_t SIM5320CellularNetwork::get_attach(CellularNetwork::AttachStatus &status)
+{
+    return get_attach(status, false);
+}
+
+nsapi_error_t SIM5320CellularNetwork::get_attach(CellularNetwork::AttachStatus &status, bool force_refresh)
 {
     int attach_status;
-    nsapi_error_t err = _at.at_cmd_int("+CGATT", "?", attach_status);
+    uint32_t cached_attach_status;
+    nsapi_error_t err;
+
+    if (!force_refresh && _settings_cache && _settings_cache->get(SIM5320SettingsCache::CGATT, cached_attach_status)) {
+        status = (cached_attach_status == 1) ? Attached : Detached;
+        return NSAPI_ERROR_OK;
+    }
+
+    err = _at.at_cmd_int("+CGATT", "?", attach_status);
     status = (attach_status == 1) ? Attached : Detached;
+    if (_settings_cache && !err) {
+        _settings_cache->set(SIM5320SettingsCache::CGATT, attach_status);
+    }
 
     return err;
 }
@@ -216,6 +244,9 @@ nsapi_error_t SIM5320CellularNetwork::detach()
 
     tr_debug("Network detach");
     _at.at_cmd_discard("+CGATT", "=0");
+    if (_settings_cache && !_at.get_last_error()) {
+        _settings_cache->set(SIM5320SettingsCache::CGATT, 0);
+    }
     _at.at_cmd_discard("+COPS", "=2");
 
     if (_connection_status_cb) {
@@ -506,6 +537,9 @@ static CellularNetwork::RadioAccessTechnology rat_codes[] = {
 
 nsapi_error_t SIM5320CellularNetwork::set_preffered_radio_access_technology_mode(SIM5320CellularNetwork::SIM5320PreferredRadioAccessTechnologyMode aop)
 {
+    if (_settings_cache) {
+        return _settings_cache->write_i(_at, SIM5320SettingsCache::CNMP, "+CNMP", (int)aop);
+    }
     return _at.at_cmd_discard("+CNMP", "=", "%d", (int)aop);
 }
 
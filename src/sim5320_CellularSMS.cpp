@@ -2,6 +2,7 @@
 
 #include "mbed_chrono.h"
 
+#include "sim5320_CellularDevice.h"
 #include "sim5320_CellularSMS.h"
 
 #include "sim5320_trace.h"
@@ -42,8 +43,14 @@ nsapi_error_t SIM5320CellularSMS::get_sms_message_mode(CellularSMS::CellularSMSM
     return err;
 }
 
-SIM5320CellularSMS::SIM5320CellularSMS(ATHandler &at_handler)
+nsapi_error_t SIM5320CellularSMS::wait_phonebook_ready()
+{
+    return _device ? _device->wait_phonebook_ready() : NSAPI_ERROR_OK;
+}
+
+SIM5320CellularSMS::SIM5320CellularSMS(ATHandler &at_handler, SIM5320CellularDevice *device)
     : _at(at_handler)
+    , _device(device)
 {
     // configure SMS callbacks
     _at.set_urc_handler("+CMTI:", callback(this, &SIM5320CellularSMS::_cmti_urc));
@@ -70,6 +77,11 @@ nsapi_error_t SIM5320CellularSMS::initialize(CellularSMS::CellularSMSMmode mode,
 
     _use_8bit_encoding = (encoding == CellularSMSEncoding8Bit);
 
+    nsapi_error_t err = wait_phonebook_ready();
+    if (err) {
+        return err;
+    }
+
     ATHandlerLocker locker(_at);
     // sms configuration
     _at.at_cmd_discard("+CNMI", "=2,1");
@@ -88,6 +100,9 @@ nsapi_size_or_error_t SIM5320CellularSMS::send_sms(const char *phone_number, con
     // so implement SMS sending for text mode
     nsapi_error_t err;
     CellularSMSMmode mode;
+    if ((err = wait_phonebook_ready())) {
+        return err;
+    }
     err = get_sms_message_mode(mode);
     if (err) {
         return err;
@@ -149,6 +164,9 @@ nsapi_size_or_error_t SIM5320CellularSMS::get_sms(char *buf, uint16_t buf_len, c
         return NSAPI_ERROR_NO_MEMORY;
     }
 
+    if ((err = wait_phonebook_ready())) {
+        return err;
+    }
     err = get_sms_message_mode(mode);
     if (err) {
         return err;
@@ -248,6 +266,10 @@ nsapi_size_or_error_t SIM5320CellularSMS::set_cscs(const char *chr_set)
 
 nsapi_error_t SIM5320CellularSMS::delete_all_messages()
 {
+    nsapi_error_t err = wait_phonebook_ready();
+    if (err) {
+        return err;
+    }
     return _at.at_cmd_discard("+CMGD", "=1,4");
 }
 
@@ -1,28 +1,99 @@
 #include "sim5320_FTPClient.h"
 
 #include "mbed_chrono.h"
+#include "mbedtls/sha256.h"
 
 #include <chrono>
 #include <string.h>
+#include <strings.h>
+#include <time.h>
 
+#include "sim5320_LZSSCodec.h"
+#include "sim5320_SettingsCache.h"
 #include "sim5320_trace.h"
 #include "sim5320_utils.h"
 
 using mbed::chrono::milliseconds_u32;
 using namespace sim5320;
 
+#define to_ms_u32(value) std::chrono::duration_cast<milliseconds_u32>(value)
+
 static constexpr milliseconds_u32 FTP_RESPONSE_TIMEOUT = 24s;
 static constexpr int FTP_DEVICE_TIMEOUT = 20;
 
+#define FTP_TRANSFER_DATA_FLAG 0x01
+#define FTP_TRANSFER_END_FLAG 0x02
+#define FTP_MODEM_TRANSFER_END_FLAG 0x04
+
+void SIM5320FTPClient::_urc_cftps_recv_event()
+{
+    // new data is available in the cache
+    _transfer_flags.set(FTP_TRANSFER_DATA_FLAG);
+}
+
+void SIM5320FTPClient::_urc_cftpsget()
+{
+    // end of the transmission: "+CFTPSGET: <code>" or "+CFTPSLIST: <code>"
+    int code = _at.read_int();
+    _transfer_code = code < 0 ? 2 : code;
+    _transfer_flags.set(FTP_TRANSFER_END_FLAG);
+}
+
+// default job retry policy
+static const int FTP_JOB_DEFAULT_MAX_ATTEMPTS = 3;
+static constexpr milliseconds_u32 FTP_JOB_DEFAULT_RETRY_DELAY = 1s;
+
 SIM5320FTPClient::SIM5320FTPClient(ATHandler &at)
     : _at(at)
     , _buffer(nullptr)
     , _cleanup_buffer(false)
+    , _transfer_code(-1)
+    , _producer_queue(nullptr)
+    , _producer_own_queue(nullptr)
+    , _producer_thread(nullptr)
+    , _producer_buffer(nullptr)
+    , _cleanup_producer_buffer(false)
+    , _put_bandwidth(0)
+    , _cooperative_mode(false)
+    , _encoder(nullptr)
+    , _decoder(nullptr)
+    , _session_lock_depth(0)
+    , _connected(false)
+    , _session_lost(false)
+    , _auto_reconnect(false)
+    , _keep_alive_queue(nullptr)
+    , _keep_alive_event_id(0)
+    , _keep_alive_interval(0)
+    , _modem_transfer_code(NSAPI_ERROR_OK)
+    , _modem_transfer_pending(false)
+    , _progress_cb(nullptr)
+    , _jobs_head(nullptr)
+    , _jobs_tail(nullptr)
+    , _job_max_attempts(FTP_JOB_DEFAULT_MAX_ATTEMPTS)
+    , _job_retry_delay(FTP_JOB_DEFAULT_RETRY_DELAY)
 {
+    memset(&_transfer_stats, 0, sizeof(_transfer_stats));
+    memset(&_session_params, 0, sizeof(_session_params));
+    _at.set_urc_handler("+CFTPS: RECV EVENT", callback(this, &SIM5320FTPClient::_urc_cftps_recv_event));
+    _at.set_urc_handler("+CFTPSGET:", callback(this, &SIM5320FTPClient::_urc_cftpsget));
+    _at.set_urc_handler("+CFTPSLIST:", callback(this, &SIM5320FTPClient::_urc_cftpsget));
+    _at.set_urc_handler("+CFTPSNOTIFY:", callback(this, &SIM5320FTPClient::_urc_cftpsnotify));
+    _at.set_urc_handler("+CFTPSGETFILE:", callback(this, &SIM5320FTPClient::_urc_cftps_file));
+    _at.set_urc_handler("+CFTPSPUTFILE:", callback(this, &SIM5320FTPClient::_urc_cftps_file));
 }
 
 SIM5320FTPClient::~SIM5320FTPClient()
 {
+    _at.set_urc_handler("+CFTPS: RECV EVENT", nullptr);
+    _at.set_urc_handler("+CFTPSGET:", nullptr);
+    _at.set_urc_handler("+CFTPSLIST:", nullptr);
+    _at.set_urc_handler("+CFTPSNOTIFY:", nullptr);
+    _at.set_urc_handler("+CFTPSGETFILE:", nullptr);
+    _at.set_urc_handler("+CFTPSPUTFILE:", nullptr);
+
+    set_keep_alive(0ms);
+    set_double_buffering(false);
+    set_compression(false);
     if (_cleanup_buffer) {
         delete[] _buffer;
     }
@@ -47,6 +118,53 @@ nsapi_error_t SIM5320FTPClient::set_buffer(uint8_t *buf)
     }
 }
 
+static constexpr size_t FTP_PRODUCER_QUEUE_SIZE = 4 * EVENTS_EVENT_SIZE;
+
+nsapi_error_t SIM5320FTPClient::set_double_buffering(bool enabled, EventQueue *producer_queue, uint8_t *buf)
+{
+    // cleanup previous resources
+    if (_producer_thread) {
+        _producer_own_queue->break_dispatch();
+        _producer_thread->join();
+        delete _producer_thread;
+        delete _producer_own_queue;
+        _producer_thread = nullptr;
+        _producer_own_queue = nullptr;
+    }
+    if (_cleanup_producer_buffer) {
+        delete[] _producer_buffer;
+        _cleanup_producer_buffer = false;
+    }
+    _producer_buffer = nullptr;
+    _producer_queue = nullptr;
+
+    if (!enabled) {
+        return NSAPI_ERROR_OK;
+    }
+
+    if (producer_queue == nullptr) {
+        // run own producer thread
+        _producer_own_queue = new EventQueue(FTP_PRODUCER_QUEUE_SIZE);
+        _producer_thread = new Thread(osPriorityNormal, MBED_CONF_SIM5320_DRIVER_FTP_PRODUCER_STACK_SIZE, nullptr, "sim5320_ftp");
+        if (_producer_thread->start(callback(_producer_own_queue, &EventQueue::dispatch_forever)) != osOK) {
+            delete _producer_thread;
+            delete _producer_own_queue;
+            _producer_thread = nullptr;
+            _producer_own_queue = nullptr;
+            return NSAPI_ERROR_NO_MEMORY;
+        }
+        producer_queue = _producer_own_queue;
+    }
+    if (buf == nullptr) {
+        buf = new uint8_t[BUFFER_SIZE];
+        _cleanup_producer_buffer = true;
+    }
+    _producer_buffer = buf;
+    _producer_queue = producer_queue;
+
+    return NSAPI_ERROR_OK;
+}
+
 #define FTP_ERROR_OFFSET -4000
 
 static int convert_ftp_error_code(int cmd_code)
@@ -99,9 +217,68 @@ static int read_fuzzy_ftp_response(ATHandler &at, bool wait_response_after_ok, b
         return err;          \
     }
 
+namespace sim5320 {
+/**
+ * FTP session lock.
+ *
+ * It prevents FTP commands of other threads, restores lost session before outer operation
+ * and tracks session activity for keep-alive.
+ */
+struct session_lock_t {
+    SIM5320FTPClient *ftp_client;
+    // session restoration error, guarded operations should return it without sending commands
+    nsapi_error_t err;
+
+    session_lock_t(SIM5320FTPClient *ftp_client)
+        : ftp_client(ftp_client)
+        , err(NSAPI_ERROR_OK)
+    {
+        ftp_client->_session_mutex.lock();
+        ftp_client->_session_lock_depth++;
+        // note: relogin aborts background transfer of the modem, so it's skipped till transfer end
+        if (ftp_client->_session_lock_depth == 1 && ftp_client->_session_lost && ftp_client->_auto_reconnect && !ftp_client->_modem_transfer_pending) {
+            err = ftp_client->_relogin();
+        }
+    }
+
+    ~session_lock_t()
+    {
+        ftp_client->_session_lock_depth--;
+        ftp_client->_last_activity = Kernel::Clock::now();
+        ftp_client->_session_mutex.unlock();
+    }
+};
+}
+
 nsapi_error_t SIM5320FTPClient::connect(const char *host, int port, SIM5320FTPClient::FTPProtocol protocol, const char *username, const char *password)
+{
+    nsapi_error_t err;
+    ScopedLock<Mutex> session_lock(_session_mutex);
+
+    // remember parameters to restore session if it's lost
+    session_params_t &params = _session_params;
+    params.valid = strlen(host) < sizeof(params.host) && strlen(username) < sizeof(params.username) && strlen(password) < sizeof(params.password);
+    if (params.valid) {
+        strcpy(params.host, host);
+        strcpy(params.username, username);
+        strcpy(params.password, password);
+        params.port = port;
+        params.protocol = protocol;
+    } else {
+        tr_warning("FTP session parameters are too long. Session won't be restored automatically");
+    }
+
+    err = _login(host, port, protocol, username, password);
+    _connected = err == NSAPI_ERROR_OK;
+    _session_lost = false;
+    _last_activity = Kernel::Clock::now();
+    return err;
+}
+
+nsapi_error_t SIM5320FTPClient::_login(const char *host, int port, int protocol, const char *username, const char *password)
 {
     int err;
+    ScopedLock<Mutex> session_lock(_session_mutex);
     ATHandlerLocker locker(_at, FTP_RESPONSE_TIMEOUT);
 
     // start ftp stack
@@ -211,6 +388,7 @@ nsapi_error_t SIM5320FTPClient::connect(const char *address)
 nsapi_error_t SIM5320FTPClient::disconnect()
 {
     int err;
+    ScopedLock<Mutex> session_lock(_session_mutex);
     ATHandlerLocker locker(_at, FTP_RESPONSE_TIMEOUT);
 
     // disconnect from server
@@ -221,18 +399,236 @@ nsapi_error_t SIM5320FTPClient::disconnect()
     // stop stack
     _at.cmd_start_stop("+CFTPSSTOP", "");
     err = read_fuzzy_ftp_response(_at, false, false, "+CFTPSSTOP");
+    _connected = false;
 
     return err;
 }
 
+nsapi_error_t SIM5320FTPClient::_relogin()
+{
+    ScopedLock<Mutex> session_lock(_session_mutex);
+    if (!_session_params.valid) {
+        return NSAPI_ERROR_NO_CONNECTION;
+    }
+    tr_info("Restore FTP session ...");
+    // cleanup previous session state
+    disconnect();
+    nsapi_error_t err = _login(_session_params.host, _session_params.port, _session_params.protocol, _session_params.username, _session_params.password);
+    if (!err) {
+        _connected = true;
+        _session_lost = false;
+    }
+    return err;
+}
+
+void SIM5320FTPClient::_on_session_error(int err)
+{
+    if (err == FTP_ERROR_CLOSED_CONNECTION || err == FTP_ERROR_NETWROK_ERROR || err == FTP_ERROR_SSL) {
+        _session_lost = true;
+    }
+}
+
+void SIM5320FTPClient::_urc_cftpsnotify()
+{
+    // "+CFTPSNOTIFY: PEER CLOSED"
+    tr_info("FTP session has been closed by server");
+    _session_lost = true;
+}
+
+void SIM5320FTPClient::set_auto_reconnect(bool enabled)
+{
+    _auto_reconnect = enabled;
+}
+
+bool SIM5320FTPClient::is_session_lost() const
+{
+    return _session_lost;
+}
+
+// minimal keep-alive check period
+static constexpr milliseconds_u32 FTP_KEEP_ALIVE_MIN_CHECK_PERIOD = 1s;
+
+nsapi_error_t SIM5320FTPClient::set_keep_alive(milliseconds_u32 interval, EventQueue *queue)
+{
+    if (_keep_alive_queue) {
+        _keep_alive_queue->cancel(_keep_alive_event_id);
+        _keep_alive_queue = nullptr;
+        _keep_alive_event_id = 0;
+    }
+    _keep_alive_interval = interval;
+    if (interval == 0ms) {
+        return NSAPI_ERROR_OK;
+    }
+    if (queue == nullptr) {
+        // note: the check blocks queue while AT interface is used by other threads, so shared queue isn't used by default
+        return NSAPI_ERROR_PARAMETER;
+    }
+    // check idle time twice per interval
+    milliseconds_u32 check_period = interval / 2;
+    if (check_period < FTP_KEEP_ALIVE_MIN_CHECK_PERIOD) {
+        check_period = FTP_KEEP_ALIVE_MIN_CHECK_PERIOD;
+    }
+    _keep_alive_event_id = queue->call_every(check_period, callback(this, &SIM5320FTPClient::_keep_alive_check));
+    if (_keep_alive_event_id == 0) {
+        return NSAPI_ERROR_NO_MEMORY;
+    }
+    _keep_alive_queue = queue;
+    return NSAPI_ERROR_OK;
+}
+
+void SIM5320FTPClient::_keep_alive_check()
+{
+    // skip check if some operation is in progress
+    if (!_session_mutex.trylock()) {
+        return;
+    }
+    // note: skip check during background transfer of the modem, as a failed check leads to relogin that aborts it
+    if (_connected && !_session_lost && !_modem_transfer_pending && Kernel::Clock::now() - _last_activity >= _keep_alive_interval) {
+        tr_debug("FTP keep-alive");
+        if (_is_session_lost()) {
+            tr_info("FTP session is lost");
+            _session_lost = true;
+        }
+    }
+    _session_mutex.unlock();
+}
+
+bool SIM5320FTPClient::_is_session_lost()
+{
+    // check session with a cheap command
+    char work_dir[64];
+    return get_cwd(work_dir, sizeof(work_dir)) != NSAPI_ERROR_OK;
+}
+
+/**
+ * Check if error can be fixed by job retry.
+ */
+static bool is_transient_ftp_error(int err)
+{
+    switch (err) {
+    case SIM5320FTPClient::FTP_ERROR_SSL:
+    case SIM5320FTPClient::FTP_ERROR_BUSY:
+    case SIM5320FTPClient::FTP_ERROR_CLOSED_CONNECTION:
+    case SIM5320FTPClient::FTP_ERROR_TIMEOUT:
+    case SIM5320FTPClient::FTP_ERROR_TRANSFER_FAILED:
+    case SIM5320FTPClient::FTP_ERROR_NETWROK_ERROR:
+    case NSAPI_ERROR_DEVICE_ERROR:
+    case NSAPI_ERROR_TIMEOUT:
+        return true;
+    default:
+        return false;
+    }
+}
+
+void SIM5320FTPClient::enqueue_job(SIM5320FTPClient::job_t *job)
+{
+    job->result = NSAPI_ERROR_OK;
+    job->attempts = 0;
+    job->next = nullptr;
+
+    CriticalSectionLock lock;
+    if (_jobs_tail) {
+        _jobs_tail->next = job;
+    } else {
+        _jobs_head = job;
+    }
+    _jobs_tail = job;
+}
+
+SIM5320FTPClient::job_t *SIM5320FTPClient::_dequeue_job()
+{
+    CriticalSectionLock lock;
+    job_t *job = _jobs_head;
+    if (job) {
+        _jobs_head = job->next;
+        if (_jobs_head == nullptr) {
+            _jobs_tail = nullptr;
+        }
+        job->next = nullptr;
+    }
+    return job;
+}
+
+void SIM5320FTPClient::set_job_retry_policy(int max_attempts, milliseconds_u32 retry_delay)
+{
+    _job_max_attempts = max_attempts > 0 ? max_attempts : 1;
+    _job_retry_delay = retry_delay;
+}
+
+nsapi_error_t SIM5320FTPClient::_execute_job(SIM5320FTPClient::job_t *job)
+{
+    switch (job->type) {
+    case JOB_UPLOAD:
+        return upload(job->local_path, job->remote_path);
+    case JOB_DOWNLOAD:
+        return download(job->remote_path, job->local_path);
+    case JOB_MKDIR:
+        return mkdir(job->remote_path);
+    case JOB_RMFILE:
+        return rmfile(job->remote_path);
+    case JOB_RMDIR:
+        return rmdir(job->remote_path);
+    default:
+        return NSAPI_ERROR_PARAMETER;
+    }
+}
+
+nsapi_error_t SIM5320FTPClient::run_jobs(size_t *num_failed)
+{
+    nsapi_error_t first_err = NSAPI_ERROR_OK;
+    size_t failed_count = 0;
+    job_t *job;
+    // execute jobs back-to-back without other thread FTP commands
+    session_lock_t session_lock(this);
+    // session restoration error, the remaining jobs fail with it without execution
+    nsapi_error_t session_err = session_lock.err;
+
+    while ((job = _dequeue_job()) != nullptr) {
+        while (!session_err) {
+            job->attempts++;
+            job->result = _execute_job(job);
+            if (!job->result || !is_transient_ftp_error(job->result) || job->attempts >= _job_max_attempts) {
+                break;
+            }
+            tr_info("FTP job failed with code %d. Retry it ...", job->result);
+            ThisThread::sleep_for(_job_retry_delay);
+            // login again only if session has been lost (the flag is updated by command errors and URC codes)
+            if (_session_lost && !_modem_transfer_pending) {
+                session_err = _relogin();
+                if (session_err) {
+                    tr_error("Cannot restore FTP session (code %d). Skip remaining jobs", session_err);
+                }
+            }
+        }
+        if (session_err) {
+            job->result = session_err;
+        }
+        if (job->result) {
+            failed_count++;
+            if (!first_err) {
+                first_err = job->result;
+            }
+        }
+    }
+
+    if (num_failed) {
+        *num_failed = failed_count;
+    }
+    return first_err;
+}
+
 nsapi_error_t SIM5320FTPClient::get_cwd(char *work_dir, size_t max_size)
 {
+    session_lock_t session_lock(this);
+    RETURN_IF_ERROR(session_lock.err);
     return _at.at_cmd_str("+CFTPSPWD", "", work_dir, max_size);
 }
 
 nsapi_error_t SIM5320FTPClient::set_cwd(const char *work_dir)
 {
     int err;
+    session_lock_t session_lock(this);
+    RETURN_IF_ERROR(session_lock.err);
     ATHandlerLocker locker(_at, FTP_RESPONSE_TIMEOUT);
 
     _at.cmd_start_stop("+CFTPSCWD", "=", "%s", work_dir);
@@ -247,6 +643,8 @@ nsapi_error_t SIM5320FTPClient::get_file_size(const char *path, long &size)
     int err, ftp_code;
     int cmd_fsize;
 
+    session_lock_t session_lock(this);
+    RETURN_IF_ERROR(session_lock.err);
     ATHandlerLocker locker(_at, FTP_RESPONSE_TIMEOUT);
     _at.cmd_start_stop("+CFTPSSIZE", "=", "%s", path);
     err = read_full_fuzzy_response(_at, false, false, "+CFTPSSIZE:", "%i%i", &ftp_code, &cmd_fsize);
@@ -273,6 +671,8 @@ nsapi_error_t SIM5320FTPClient::isfile(const char *path, bool &result)
 
 nsapi_error_t SIM5320FTPClient::isdir(const char *path, bool &result)
 {
+    session_lock_t session_lock(this);
+    RETURN_IF_ERROR(session_lock.err);
     ATHandlerLocker locker(_at, FTP_RESPONSE_TIMEOUT);
     int err;
     char *buf = _get_buffer();
@@ -318,6 +718,8 @@ nsapi_error_t SIM5320FTPClient::exists(const char *path, bool &result)
 nsapi_error_t SIM5320FTPClient::mkdir(const char *path)
 {
     int err;
+    session_lock_t session_lock(this);
+    RETURN_IF_ERROR(session_lock.err);
     ATHandlerLocker locker(_at, FTP_RESPONSE_TIMEOUT);
 
     _at.cmd_start_stop("+CFTPSMKD", "=", "%s", path);
@@ -330,6 +732,8 @@ nsapi_error_t SIM5320FTPClient::mkdir(const char *path)
 nsapi_error_t SIM5320FTPClient::rmdir(const char *path)
 {
     int err;
+    session_lock_t session_lock(this);
+    RETURN_IF_ERROR(session_lock.err);
     ATHandlerLocker locker(_at, FTP_RESPONSE_TIMEOUT);
 
     _at.cmd_start_stop("+CFTPSRMD", "=", "%s", path);
@@ -339,62 +743,135 @@ nsapi_error_t SIM5320FTPClient::rmdir(const char *path)
     return NSAPI_ERROR_OK;
 }
 
-nsapi_error_t SIM5320FTPClient::_rmtree_impl(char *path_buf, size_t path_buf_len)
+namespace sim5320 {
+/**
+ * Helper object to collect directory entries for removal without dynamic memory allocation.
+ *
+ * File names are stored from the beginning of the names buffer, and the first found directory name
+ * is stored at the end of the buffer.
+ */
+struct rmtree_collector_t {
+    char *names_buf;
+    size_t names_len;
+    size_t names_end;
+    const char *dir_name;
+    bool has_more;
+
+    rmtree_collector_t(char *names_buf, size_t names_buf_len)
+        : names_buf(names_buf)
+        , names_len(0)
+        , names_end(names_buf_len)
+        , dir_name(nullptr)
+        , has_more(false)
+    {
+    }
+
+    void collect(const SIM5320FTPClient::dir_entry_view &entry)
+    {
+        size_t name_size = strlen(entry.name) + 1;
+        if (name_size > names_end - names_len) {
+            // process entry during next iteration
+            has_more = true;
+        } else if (entry.d_type == DT_DIR) {
+            if (dir_name) {
+                has_more = true;
+            } else {
+                names_end -= name_size;
+                strcpy(names_buf + names_end, entry.name);
+                dir_name = names_buf + names_end;
+            }
+        } else {
+            strcpy(names_buf + names_len, entry.name);
+            names_len += name_size;
+        }
+    }
+};
+}
+
+static int append_path(char *path_buf, size_t path_len, size_t path_buf_len, const char *name)
+{
+    if (path_len + strlen(name) + 2 > path_buf_len) {
+        return MBED_ERROR_CODE_INVALID_SIZE;
+    }
+    path_buf[path_len] = '/';
+    strcpy(path_buf + path_len + 1, name);
+    return 0;
+}
+
+nsapi_error_t SIM5320FTPClient::_rmtree_impl(char *path_buf, size_t path_buf_len, char *names_buf, size_t names_buf_len)
 {
     int err;
-    SIM5320FTPClient::dir_entry_list_t dir_entry_list;
-    SIM5320FTPClient::dir_entry_t *dir_entry_ptr;
-    size_t path_len = strlen(path_buf) + 1;
+    size_t path_len = strlen(path_buf);
 
-    err = listdir(path_buf, &dir_entry_list);
-    if (err) {
-        return err;
-    }
-    for (dir_entry_ptr = dir_entry_list.get_head(); dir_entry_ptr != nullptr; dir_entry_ptr = dir_entry_ptr->next) {
-        size_t new_path_len = path_len + 1 + strlen(dir_entry_ptr->name);
-        if (new_path_len >= path_buf_len) {
-            err = MBED_ERROR_CODE_INVALID_SIZE;
+    while (true) {
+        // collect part of directory entries
+        rmtree_collector_t collector(names_buf, names_buf_len);
+        err = listdir(path_buf, callback(&collector, &rmtree_collector_t::collect));
+        if (err) {
             break;
         }
 
-        path_buf[path_len - 1] = '/';
-        strcpy(path_buf + path_len, dir_entry_ptr->name);
-        if (dir_entry_ptr->d_type == DT_REG) {
-            err = rmfile(path_buf);
-        } else {
-            err = _rmtree_impl(path_buf, path_buf_len);
+        // remove files
+        for (const char *name = names_buf; name < names_buf + collector.names_len; name += strlen(name) + 1) {
+            err = append_path(path_buf, path_len, path_buf_len, name);
+            if (!err) {
+                err = rmfile(path_buf);
+            }
+            path_buf[path_len] = '\0';
+            if (err) {
+                break;
+            }
+        }
+        if (err) {
+            break;
+        }
+
+        // remove subdirectory
+        // note: names buffer isn't used any more, so it can be reused by nested invocation
+        if (collector.dir_name) {
+            err = append_path(path_buf, path_len, path_buf_len, collector.dir_name);
+            if (!err) {
+                err = _rmtree_impl(path_buf, path_buf_len, names_buf, names_buf_len);
+            }
             if (!err) {
                 err = rmdir(path_buf);
             }
+            path_buf[path_len] = '\0';
+            if (err) {
+                break;
+            }
         }
 
-        if (err) {
+        if (!collector.has_more) {
             break;
         }
     }
-    path_buf[path_len - 1] = '\0';
     return err;
 }
 
+#define RMTREE_PATH_BUF_LEN 256
+#define RMTREE_NAMES_BUF_LEN 256
+
 nsapi_error_t SIM5320FTPClient::rmtree(const char *path, bool remove_root)
 {
-    const size_t path_buf_len = 256;
-    if (strlen(path) > path_buf_len) {
+    char path_buf[RMTREE_PATH_BUF_LEN];
+    char names_buf[RMTREE_NAMES_BUF_LEN];
+    if (strlen(path) >= RMTREE_PATH_BUF_LEN) {
         return MBED_ERROR_INVALID_SIZE;
     }
-    char *path_buf = new char[path_buf_len];
     strcpy(path_buf, path);
-    int err = _rmtree_impl(path_buf, path_buf_len);
+    int err = _rmtree_impl(path_buf, RMTREE_PATH_BUF_LEN, names_buf, RMTREE_NAMES_BUF_LEN);
     if (!err && remove_root) {
         err = rmdir(path);
     }
-    delete[] path_buf;
     return err;
 }
 
 nsapi_error_t SIM5320FTPClient::rmfile(const char *path)
 {
     int err;
+    session_lock_t session_lock(this);
+    RETURN_IF_ERROR(session_lock.err);
     ATHandlerLocker locker(_at, FTP_RESPONSE_TIMEOUT);
 
     _at.cmd_start_stop("+CFTPSDELE", "=", "%s", path);
@@ -407,6 +884,8 @@ nsapi_error_t SIM5320FTPClient::rmfile(const char *path)
 SIM5320FTPClient::dir_entry_t::dir_entry_t()
     : name(nullptr)
     , d_type(DT_UNKNOWN)
+    , size(-1)
+    , mtime(0)
 {
 }
 
@@ -417,89 +896,652 @@ SIM5320FTPClient::dir_entry_t::~dir_entry_t()
     }
 }
 
+/**
+ * Find next whitespace separated token.
+ *
+ * @param str string
+ * @param token_end token end
+ * @return token start or @c nullptr if string has no more tokens
+ */
+static const char *listdir_next_token(const char *str, const char **token_end)
+{
+    while (*str == ' ' || *str == '\t') {
+        str++;
+    }
+    if (*str == '\0') {
+        return nullptr;
+    }
+    const char *end = str;
+    while (*end != '\0' && *end != ' ' && *end != '\t') {
+        end++;
+    }
+    *token_end = end;
+    return str;
+}
+
+static bool listdir_parse_number(const char *start, const char *end, long &value)
+{
+    if (start == end) {
+        return false;
+    }
+    value = 0;
+    for (const char *pos = start; pos < end; pos++) {
+        if (*pos < '0' || *pos > '9') {
+            return false;
+        }
+        value = value * 10 + (*pos - '0');
+    }
+    return true;
+}
+
+static int listdir_parse_month(const char *start, const char *end)
+{
+    static const char *const MONTHS = "JanFebMarAprMayJunJulAugSepOctNovDec";
+    if (end - start != 3) {
+        return -1;
+    }
+    for (int i = 0; i < 12; i++) {
+        if (strncasecmp(start, MONTHS + i * 3, 3) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/**
+ * Parse time in a format "HH:MM", "HH:MMAM" or "HH:MMPM".
+ */
+static bool listdir_parse_time(const char *start, const char *end, struct tm &tm)
+{
+    long hour;
+    long min;
+    const char *column_pos = (const char *)memchr(start, ':', end - start);
+    if (column_pos == nullptr || end - column_pos < 3) {
+        return false;
+    }
+    if (!listdir_parse_number(start, column_pos, hour) || !listdir_parse_number(column_pos + 1, column_pos + 3, min)) {
+        return false;
+    }
+    if (end - column_pos == 5) {
+        // 12-hour format
+        bool pm = strncasecmp(column_pos + 3, "PM", 2) == 0;
+        if (!pm && strncasecmp(column_pos + 3, "AM", 2) != 0) {
+            return false;
+        }
+        hour = hour % 12 + (pm ? 12 : 0);
+    } else if (end - column_pos != 3) {
+        return false;
+    }
+    tm.tm_hour = hour;
+    tm.tm_min = min;
+    return true;
+}
+
+static time_t listdir_make_time(struct tm &tm)
+{
+    tm.tm_sec = 0;
+    tm.tm_isdst = 0;
+    time_t value = mktime(&tm);
+    return value < 0 ? 0 : value;
+}
+
+/**
+ * Parse unix LIST line like "-rw-r--r--   1 owner group  1234 Jan 12 10:15 file name".
+ */
+static bool listdir_parse_unix_line(char *line, SIM5320FTPClient::dir_entry_view &entry)
+{
+    const char *token;
+    const char *token_end;
+    const char *prev_token = nullptr;
+    const char *prev_token_end = nullptr;
+    const char *pos = line;
+    long value;
+    int month = -1;
+    struct tm tm;
+    memset(&tm, 0, sizeof(tm));
+
+    switch (line[0]) {
+    case 'd':
+        entry.d_type = DT_DIR;
+        break;
+    case '-':
+        entry.d_type = DT_REG;
+        break;
+    case 'l':
+        entry.d_type = DT_LNK;
+        break;
+    default:
+        entry.d_type = DT_UNKNOWN;
+    }
+
+    // find "<size> <month>" pair, as owner and group columns are optional for some servers
+    for (int i = 0; i < 6 && month < 0; i++) {
+        token = listdir_next_token(pos, &token_end);
+        if (token == nullptr) {
+            return false;
+        }
+        if (i >= 2 && listdir_parse_number(prev_token, prev_token_end, value)) {
+            month = listdir_parse_month(token, token_end);
+            entry.size = value;
+        }
+        prev_token = token;
+        prev_token_end = token_end;
+        pos = token_end;
+    }
+    if (month < 0) {
+        return false;
+    }
+    tm.tm_mon = month;
+
+    // day
+    token = listdir_next_token(pos, &token_end);
+    if (token == nullptr || !listdir_parse_number(token, token_end, value)) {
+        return false;
+    }
+    tm.tm_mday = value;
+    pos = token_end;
+
+    // time or year
+    token = listdir_next_token(pos, &token_end);
+    if (token == nullptr) {
+        return false;
+    }
+    if (listdir_parse_number(token, token_end, value)) {
+        tm.tm_year = value - 1900;
+    } else if (listdir_parse_time(token, token_end, tm)) {
+        // recent files have no year, so take it from the current time
+        time_t now = time(nullptr);
+        struct tm now_tm;
+        gmtime_r(&now, &now_tm);
+        tm.tm_year = now_tm.tm_year;
+        if (listdir_make_time(tm) > now + 86400) {
+            tm.tm_year--;
+        }
+    } else {
+        return false;
+    }
+    entry.mtime = listdir_make_time(tm);
+    pos = token_end;
+
+    // name is rest of the line
+    if (*pos == '\0') {
+        return false;
+    }
+    pos++;
+    if (entry.d_type == DT_LNK) {
+        // strip link target
+        char *link_pos = strstr(line + (pos - line), " -> ");
+        if (link_pos) {
+            *link_pos = '\0';
+        }
+    }
+    entry.name = pos;
+    return true;
+}
+
+/**
+ * Parse DOS LIST line like "01-12-20  10:15AM       <DIR>          dir name".
+ */
+static bool listdir_parse_dos_line(char *line, SIM5320FTPClient::dir_entry_view &entry)
+{
+    const char *token;
+    const char *token_end;
+    long value;
+    struct tm tm;
+    memset(&tm, 0, sizeof(tm));
+
+    // date: "MM-DD-YY" or "MM-DD-YYYY"
+    token = listdir_next_token(line, &token_end);
+    if (token == nullptr || token_end - token < 8 || token[2] != '-' || token[5] != '-') {
+        return false;
+    }
+    if (!listdir_parse_number(token, token + 2, value)) {
+        return false;
+    }
+    tm.tm_mon = value - 1;
+    if (!listdir_parse_number(token + 3, token + 5, value)) {
+        return false;
+    }
+    tm.tm_mday = value;
+    if (!listdir_parse_number(token + 6, token_end, value)) {
+        return false;
+    }
+    if (value < 70) {
+        value += 2000;
+    } else if (value < 100) {
+        value += 1900;
+    }
+    tm.tm_year = value - 1900;
+
+    // time
+    token = listdir_next_token(token_end, &token_end);
+    if (token == nullptr || !listdir_parse_time(token, token_end, tm)) {
+        return false;
+    }
+    entry.mtime = listdir_make_time(tm);
+
+    // size or directory mark
+    token = listdir_next_token(token_end, &token_end);
+    if (token == nullptr) {
+        return false;
+    }
+    if (token_end - token == 5 && strncmp(token, "<DIR>", 5) == 0) {
+        entry.d_type = DT_DIR;
+    } else if (listdir_parse_number(token, token_end, value)) {
+        entry.d_type = DT_REG;
+        entry.size = value;
+    } else {
+        return false;
+    }
+
+    // name is rest of the line
+    token = listdir_next_token(token_end, &token_end);
+    if (token == nullptr) {
+        return false;
+    }
+    entry.name = token;
+    return true;
+}
+
 namespace sim5320 {
-struct listdir_callback_t {
-    SIM5320FTPClient::dir_entry_list_t *dir_entry_list;
-    static const size_t MAX_WORD_SIZE = 63;
-    char word_buf[MAX_WORD_SIZE];
-    size_t word_i;
-    char current_d_type;
-    bool line_start;
+/**
+ * Streaming parser of the LIST command output.
+ *
+ * It supports unix ("ls -l" like) and DOS formats. The parser doesn't use dynamic memory allocation
+ * and passes each entry to the callback.
+ */
+struct listdir_parser_t {
+    Callback<void(const SIM5320FTPClient::dir_entry_view &)> entry_cb;
+    static const size_t LINE_BUF_SIZE = 256;
+    char line_buf[LINE_BUF_SIZE];
+    size_t line_len;
+
+    listdir_parser_t(Callback<void(const SIM5320FTPClient::dir_entry_view &)> entry_cb)
+        : entry_cb(entry_cb)
+        , line_len(0)
+    {
+    }
 
     ssize_t process(uint8_t *buf, size_t len)
     {
         for (size_t i = 0; i < len; i++) {
             char sym = buf[i];
-            if (sym == ' ') {
-                // check <DIR> and skip word
-                if (word_i >= 5 && current_d_type == DT_UNKNOWN) {
-                    if (strncmp(word_buf, "<DIR>", 5) == 0) {
-                        current_d_type = DT_DIR;
-                    }
-                }
-                word_i = 0;
-            } else if (sym == '\n' || sym == '\r') {
+            if (sym == '\n' || sym == '\r') {
                 // ignore multiple '\n' and '\r'
-                if (!line_start) {
-                    // assume that last word is filename
-                    SIM5320FTPClient::dir_entry_t *dir_entry_ptr = dir_entry_list->add_new();
-                    dir_entry_ptr->d_type = current_d_type != DT_UNKNOWN ? current_d_type : DT_REG;
-                    dir_entry_ptr->name = new char[word_i + 1];
-                    strncpy(dir_entry_ptr->name, word_buf, word_i);
-                    dir_entry_ptr->name[word_i] = '\0';
-                    line_start = true;
-                    current_d_type = DT_UNKNOWN;
-                    word_i = 0;
-                }
-            } else {
-                if (line_start) {
-                    // check entity type
-                    if (sym == 'd') {
-                        current_d_type = DT_DIR;
-                    } else if (sym == '-') {
-                        current_d_type = DT_REG;
-                    }
-                    // else: it's probably window output, so try to find <DIR> later
-                    line_start = false;
-                }
-
-                // add symbol to current word
-                if (word_i < MAX_WORD_SIZE) {
-                    word_buf[word_i] = sym;
-                    word_i++;
+                if (line_len > 0) {
+                    line_buf[line_len] = '\0';
+                    process_line();
+                    line_len = 0;
                 }
+            } else if (line_len < LINE_BUF_SIZE - 1) {
+                // note: too long lines are truncated
+                line_buf[line_len] = sym;
+                line_len++;
             }
         }
 
         return len;
     }
+
+    void process_line()
+    {
+        SIM5320FTPClient::dir_entry_view entry;
+        entry.name = nullptr;
+        entry.d_type = DT_UNKNOWN;
+        entry.size = -1;
+        entry.mtime = 0;
+
+        bool parsed;
+        if (line_buf[0] >= '0' && line_buf[0] <= '9') {
+            parsed = listdir_parse_dos_line(line_buf, entry);
+        } else {
+            parsed = listdir_parse_unix_line(line_buf, entry);
+        }
+        if (!parsed) {
+            // skip lines like "total 12"
+            tr_debug("Skip LIST line \"%s\"", line_buf);
+            return;
+        }
+
+        // skip current and parent directory entries
+        if (entry.name[0] == '\0' || strcmp(entry.name, ".") == 0 || strcmp(entry.name, "..") == 0) {
+            return;
+        }
+        entry_cb(entry);
+    }
+};
+
+/**
+ * Helper object to build list of the directory entries.
+ */
+struct dir_entry_list_builder_t {
+    SIM5320FTPClient::dir_entry_list_t *dir_entry_list;
+
+    dir_entry_list_builder_t(SIM5320FTPClient::dir_entry_list_t *dir_entry_list)
+        : dir_entry_list(dir_entry_list)
+    {
+    }
+
+    void add(const SIM5320FTPClient::dir_entry_view &entry)
+    {
+        SIM5320FTPClient::dir_entry_t *dir_entry_ptr = dir_entry_list->add_new();
+        dir_entry_ptr->d_type = entry.d_type;
+        dir_entry_ptr->size = entry.size;
+        dir_entry_ptr->mtime = entry.mtime;
+        dir_entry_ptr->name = new char[strlen(entry.name) + 1];
+        strcpy(dir_entry_ptr->name, entry.name);
+    }
 };
 }
 
+nsapi_error_t SIM5320FTPClient::listdir(const char *path, Callback<void(const SIM5320FTPClient::dir_entry_view &)> entry_cb)
+{
+    listdir_parser_t listdir_parser(entry_cb);
+    return _get_data_impl(path, callback(&listdir_parser, &listdir_parser_t::process), "LIST");
+}
+
 nsapi_error_t SIM5320FTPClient::listdir(const char *path, SIM5320FTPClient::dir_entry_list_t *dir_entry_list)
 {
-    listdir_callback_t listdir_callback;
-    listdir_callback.current_d_type = DT_UNKNOWN;
-    listdir_callback.dir_entry_list = dir_entry_list;
-    listdir_callback.line_start = true;
-    listdir_callback.word_i = 0;
-    return _get_data_impl(path, callback(&listdir_callback, &listdir_callback_t::process), "LIST");
+    dir_entry_list_builder_t dir_entry_list_builder(dir_entry_list);
+    return listdir(path, callback(&dir_entry_list_builder, &dir_entry_list_builder_t::add));
 }
 
 #define PUT_UNSEND_MAX 6144
 #define PUT_UNSEND_MIN 2048
-static constexpr size_t FTP_PUT_DATA_WAIT_TIMEOUT_SCHEME_SIZE = 8;
-static constexpr milliseconds_u32 FTP_PUT_DATA_WAIT_TIMEOUT_SCHEME[FTP_PUT_DATA_WAIT_TIMEOUT_SCHEME_SIZE] = { 1ms, 5ms, 20ms, 50ms, 100ms, 200ms, 500ms, 1000ms };
+#define PUT_MIN_BLOCK_SIZE 256
+static constexpr milliseconds_u32 FTP_PUT_DATA_MIN_WAIT_TIME = 1ms;
+static constexpr milliseconds_u32 FTP_PUT_DATA_MAX_WAIT_TIME = 1000ms;
+// wait time if upload bandwidth isn't known yet
+static constexpr milliseconds_u32 FTP_PUT_DATA_DEFAULT_WAIT_TIME = 20ms;
 #define FTP_HACK_BLOCK_SIZE 163840
 #define FTP_HACK_BLOCK_DELAY 1000
 
-nsapi_error_t SIM5320FTPClient::put(const char *path, Callback<ssize_t(uint8_t *, size_t)> data_writer)
-{
-    if (!path) {
+// minimal period to calculate current throughput
+static constexpr milliseconds_u32 TRANSFER_STATS_SAMPLE_PERIOD = 250ms;
+
+namespace sim5320 {
+/**
+ * Helper object to collect transfer statistics and notify progress callback.
+ */
+struct transfer_stats_tracker_t {
+    SIM5320FTPClient *ftp_client;
+    SIM5320FTPClient::transfer_stats_t stats;
+    Timer timer;
+    milliseconds_u32 sample_time;
+    uint32_t sample_bytes;
+
+    transfer_stats_tracker_t(SIM5320FTPClient *ftp_client)
+        : ftp_client(ftp_client)
+        , sample_time(0)
+        , sample_bytes(0)
+    {
+        memset(&stats, 0, sizeof(stats));
+        timer.start();
+        commit();
+    }
+
+    void on_data(size_t size)
+    {
+        stats.bytes_done += size;
+        update();
+    }
+
+    void on_cache_empty()
+    {
+        stats.cache_empty_waits++;
+        update();
+    }
+
+    void on_buffer_full(int pending)
+    {
+        stats.buffer_full_waits++;
+        stats.modem_pending = pending;
+        update();
+    }
+
+    void on_pending(int pending)
+    {
+        stats.modem_pending = pending;
+    }
+
+    void update()
+    {
+        milliseconds_u32 now = to_ms_u32(timer.elapsed_time());
+        stats.elapsed_ms = now.count();
+        if (now.count() > 0) {
+            stats.average_throughput = (uint64_t)stats.bytes_done * 1000 / now.count();
+        }
+        if (now - sample_time >= TRANSFER_STATS_SAMPLE_PERIOD) {
+            uint32_t sample = (uint64_t)(stats.bytes_done - sample_bytes) * 1000 / (now - sample_time).count();
+            stats.current_throughput = sample_bytes ? (stats.current_throughput + sample) / 2 : sample;
+            sample_time = now;
+            sample_bytes = stats.bytes_done;
+        }
+        commit();
+        if (ftp_client->_progress_cb) {
+            ftp_client->_progress_cb(stats);
+        }
+    }
+
+    void commit()
+    {
+        CriticalSectionLock lock;
+        ftp_client->_transfer_stats = stats;
+    }
+};
+}
+
+namespace sim5320 {
+/**
+ * Helper flow controller for FTP upload.
+ *
+ * It estimates amount of unsent data in the device buffer and the device upload rate
+ * using results of the successive "AT+CFTPSPUT?" queries.
+ *
+ * The estimated rate is used only to choose wait time before next query. The free space is calculated
+ * from the last query result and data that is sent after it, so wrong estimation cannot overflow device buffer.
+ */
+struct put_flow_controller_t {
+    Timer timer;
+    // estimated upload bandwidth in bytes per second (0 if it's unknown)
+    uint32_t bandwidth;
+    // last query results
+    int query_pending;
+    milliseconds_u32 query_time;
+    int sent_since_query;
+    bool has_query;
+
+    // note: link quality can be changed since previous transfer, so initial bandwidth is halved till first measurements
+    put_flow_controller_t(uint32_t initial_bandwidth)
+        : bandwidth(initial_bandwidth / 2)
+        , query_pending(0)
+        , query_time(0)
+        , sent_since_query(0)
+        , has_query(false)
+    {
+        timer.start();
+    }
+
+    milliseconds_u32 now()
+    {
+        return to_ms_u32(timer.elapsed_time());
+    }
+
+    int estimate_pending()
+    {
+        int pending = query_pending + sent_since_query;
+        if (has_query && bandwidth > 0) {
+            uint64_t drained = (uint64_t)bandwidth * (now() - query_time).count() / 1000;
+            pending = drained >= (uint64_t)pending ? 0 : pending - (int)drained;
+        }
+        return pending;
+    }
+
+    size_t get_free_space()
+    {
+        // upper bound of the unsent data: device cannot have more data than it has reported plus sent one
+        int pending = query_pending + sent_since_query;
+        return pending < PUT_UNSEND_MAX ? PUT_UNSEND_MAX - pending : 0;
+    }
+
+    void on_sent(size_t size)
+    {
+        sent_since_query += size;
+    }
+
+    void on_query(int pending)
+    {
+        milliseconds_u32 query_end = now();
+        if (has_query && query_end > query_time) {
+            int drained = query_pending + sent_since_query - pending;
+            if (drained > 0) {
+                uint32_t sample = (uint64_t)drained * 1000 / (query_end - query_time).count();
+                // if device buffer is empty, it could be idle some time, so the sample shows lower bound of bandwidth
+                if (pending > 0 || sample > bandwidth) {
+                    // exponential moving average
+                    bandwidth = bandwidth ? (3 * (uint64_t)bandwidth + sample) / 4 : sample;
+                }
+            }
+        }
+        query_pending = pending;
+        query_time = query_end;
+        sent_since_query = 0;
+        has_query = true;
+    }
+
+    milliseconds_u32 get_wait_time()
+    {
+        // wait till device sends data up to PUT_UNSEND_MIN level
+        int excess = estimate_pending() - PUT_UNSEND_MIN;
+        milliseconds_u32 wait_time;
+        if (bandwidth == 0) {
+            return FTP_PUT_DATA_DEFAULT_WAIT_TIME;
+        }
+        if (excess <= 0) {
+            return FTP_PUT_DATA_MIN_WAIT_TIME;
+        }
+        wait_time = milliseconds_u32((uint64_t)excess * 1000 / bandwidth);
+        if (wait_time < FTP_PUT_DATA_MIN_WAIT_TIME) {
+            wait_time = FTP_PUT_DATA_MIN_WAIT_TIME;
+        } else if (wait_time > FTP_PUT_DATA_MAX_WAIT_TIME) {
+            wait_time = FTP_PUT_DATA_MAX_WAIT_TIME;
+        }
+        return wait_time;
+    }
+};
+}
+
+namespace sim5320 {
+/**
+ * Data writer that requests next data block in the producer context, while the previous one is transmitted.
+ */
+struct double_buffer_writer_t {
+    Callback<ssize_t(uint8_t *, size_t)> data_writer;
+    EventQueue *queue;
+    uint8_t *fill_buf;
+    size_t fill_buf_size;
+
+    ssize_t fill_res;
+    size_t fill_pos;
+    bool fill_pending;
+    Semaphore fill_done;
+
+    double_buffer_writer_t(Callback<ssize_t(uint8_t *, size_t)> data_writer, EventQueue *queue, uint8_t *fill_buf, size_t fill_buf_size)
+        : data_writer(data_writer)
+        , queue(queue)
+        , fill_buf(fill_buf)
+        , fill_buf_size(fill_buf_size)
+        , fill_res(0)
+        , fill_pos(0)
+        , fill_pending(false)
+        , fill_done(0)
+    {
+    }
+
+    void fill()
+    {
+        fill_res = data_writer(fill_buf, fill_buf_size);
+        fill_done.release();
+    }
+
+    ssize_t start_fill()
+    {
+        fill_pos = 0;
+        fill_pending = queue->call(callback(this, &double_buffer_writer_t::fill)) != 0;
+        return fill_pending ? 0 : NSAPI_ERROR_NO_MEMORY;
+    }
+
+    void wait_fill()
+    {
+        if (fill_pending) {
+            fill_done.acquire();
+            fill_pending = false;
+        }
+    }
+
+    ssize_t fetch(uint8_t *buf, size_t len)
+    {
+        ssize_t res;
+        wait_fill();
+        if (fill_res <= 0) {
+            // end of data or error
+            return fill_res;
+        } else if ((size_t)fill_res > fill_buf_size) {
+            // user error
+            return NSAPI_ERROR_PARAMETER;
+        }
+
+        // move data to transmission buffer
+        res = (size_t)fill_res - fill_pos < len ? (size_t)fill_res - fill_pos : len;
+        memcpy(buf, fill_buf + fill_pos, res);
+        fill_pos += res;
+
+        // request next block, while current one is transmitted
+        if (fill_pos >= (size_t)fill_res) {
+            ssize_t err = start_fill();
+            if (err) {
+                return err;
+            }
+        }
+        return res;
+    }
+};
+}
+
+nsapi_error_t SIM5320FTPClient::put(const char *path, Callback<ssize_t(uint8_t *, size_t)> data_writer)
+{
+    // note: hold session lock, as codec state is shared between transfers
+    session_lock_t session_lock(this);
+    RETURN_IF_ERROR(session_lock.err);
+    if (_encoder) {
+        // compress data before sending
+        _encoder->start(data_writer);
+        data_writer = callback(_encoder, &LZSSEncoder::read);
+    }
+
+    if (!_producer_queue) {
+        return _put_impl(path, data_writer);
+    }
+
+    double_buffer_writer_t double_buffer_writer(data_writer, _producer_queue, _producer_buffer, BUFFER_SIZE);
+    nsapi_error_t err = double_buffer_writer.start_fill();
+    if (!err) {
+        err = _put_impl(path, callback(&double_buffer_writer, &double_buffer_writer_t::fetch));
+    }
+    // ensure that producer doesn't use writer object
+    double_buffer_writer.wait_fill();
+    return err;
+}
+
+nsapi_error_t SIM5320FTPClient::_put_impl(const char *path, Callback<ssize_t(uint8_t *, size_t)> data_writer)
+{
+    if (!path) {
         return NSAPI_ERROR_PARAMETER;
     }
 
     int err;
+    session_lock_t session_lock(this);
+    RETURN_IF_ERROR(session_lock.err);
     ATHandlerLocker locker(_at, FTP_RESPONSE_TIMEOUT);
 
     char *buf = _get_buffer();
@@ -507,48 +1549,63 @@ nsapi_error_t SIM5320FTPClient::put(const char *path, Callback<ssize_t(uint8_t *
     ssize_t block_size = 1;
     ssize_t total_size = 0;
     int data_writer_error = 0;
-    int pending_data_i = PUT_UNSEND_MAX + 1;
-    size_t put_wait_timeout_scheme_i;
+    int pending_data;
+    size_t free_space;
+    size_t block_size_limit;
+    put_flow_controller_t flow_controller(_put_bandwidth);
+    transfer_stats_tracker_t stats_tracker(this);
 
     while (true) {
-        // as the operation can be long we should reset ATHanlder timeout
-        // TODO: check if it's better to release lock and invoke ThisThread::yield to
-        // allow other thread to use this driver.
-        locker.reset_timeout();
+        if (_cooperative_mode) {
+            // allow other threads to use device between data blocks
+            locker.unlock();
+            ThisThread::yield();
+            locker.lock();
+        } else {
+            // as the operation can be long we should reset ATHanlder timeout
+            locker.reset_timeout();
+        }
 
-        // check if we have some amount of unsent data
-        if (pending_data_i >= PUT_UNSEND_MAX) {
-            // wait till output buffer become empty almost empty
-            put_wait_timeout_scheme_i = 0;
+        // check if device buffer has enough space for next block
+        free_space = flow_controller.get_free_space();
+        if (free_space < PUT_MIN_BLOCK_SIZE) {
             while (true) {
-                _at.at_cmd_int("+CFTPSPUT", "?", pending_data_i, "");
+                // wait till device sends part of data
+                if (_cooperative_mode) {
+                    locker.unlock();
+                    ThisThread::sleep_for(flow_controller.get_wait_time());
+                    locker.lock();
+                } else {
+                    ThisThread::sleep_for(flow_controller.get_wait_time());
+                }
+                _at.at_cmd_int("+CFTPSPUT", "?", pending_data, "");
                 // exit if error
                 if (_at.get_last_error()) {
                     break;
                 }
-                if (pending_data_i > PUT_UNSEND_MIN) {
-                    ThisThread::sleep_for(FTP_PUT_DATA_WAIT_TIMEOUT_SCHEME[put_wait_timeout_scheme_i]);
-                    if (put_wait_timeout_scheme_i < (FTP_PUT_DATA_WAIT_TIMEOUT_SCHEME_SIZE + 1)) {
-                        put_wait_timeout_scheme_i++;
-                    }
-                } else {
+                flow_controller.on_query(pending_data);
+                free_space = flow_controller.get_free_space();
+                if (free_space >= PUT_MIN_BLOCK_SIZE) {
+                    stats_tracker.on_pending(pending_data);
                     break;
                 }
+                stats_tracker.on_buffer_full(pending_data);
             }
             // exit if error
             if (_at.get_last_error()) {
                 break;
             }
         }
+        block_size_limit = free_space < BUFFER_SIZE ? free_space : BUFFER_SIZE;
 
         // get data from user code
-        block_size = data_writer((uint8_t *)buf, BUFFER_SIZE);
+        block_size = data_writer((uint8_t *)buf, block_size_limit);
         if (block_size <= 0) {
             // finish transmission
             // if block_size < 0, it will be considered as error code
             data_writer_error = block_size;
             break;
-        } else if ((size_t)block_size > BUFFER_SIZE) {
+        } else if ((size_t)block_size > block_size_limit) {
             // user error
             data_writer_error = NSAPI_ERROR_PARAMETER;
             break;
@@ -566,13 +1623,16 @@ nsapi_error_t SIM5320FTPClient::put(const char *path, Callback<ssize_t(uint8_t *
         _at.resp_start(">", true);
         _at.write_bytes((uint8_t *)buf, block_size);
 
-        pending_data_i += block_size;
+        flow_controller.on_sent(block_size);
+        stats_tracker.on_data(block_size);
         // get OK confirmation
         _at.resp_start("*", true);
         if (_at.get_last_error()) {
             break;
         }
     }
+    // save bandwidth estimation for next transfers
+    _put_bandwidth = flow_controller.bandwidth;
     // mark that transmission has been finished, even error occurs
     err = _at.get_last_error();
     _at.clear_error();
@@ -580,6 +1640,7 @@ nsapi_error_t SIM5320FTPClient::put(const char *path, Callback<ssize_t(uint8_t *
     if (total_size != 0) {
         _at.cmd_start_stop("+CFTPSPUT", "");
         err = read_fuzzy_ftp_response(_at, true, false, "+CFTPSPUT");
+        _on_session_error(err);
         RETURN_IF_ERROR(err);
     } else {
         // note: sim5320 implementation doesn't allow to create empty files, so skip them
@@ -613,18 +1674,174 @@ struct buffer_reader_t {
 };
 }
 
+void SIM5320FTPClient::set_cooperative_mode(bool enabled)
+{
+    _cooperative_mode = enabled;
+}
+
+nsapi_error_t SIM5320FTPClient::set_compression(bool enabled)
+{
+    if (enabled) {
+        if (_encoder == nullptr) {
+            _encoder = new LZSSEncoder();
+            _decoder = new LZSSDecoder();
+        }
+    } else {
+        delete _encoder;
+        delete _decoder;
+        _encoder = nullptr;
+        _decoder = nullptr;
+    }
+    return NSAPI_ERROR_OK;
+}
+
+void SIM5320FTPClient::set_progress_callback(Callback<void(const SIM5320FTPClient::transfer_stats_t &)> progress_cb)
+{
+    _progress_cb = progress_cb;
+}
+
+void SIM5320FTPClient::get_transfer_stats(SIM5320FTPClient::transfer_stats_t &stats) const
+{
+    CriticalSectionLock lock;
+    stats = _transfer_stats;
+}
+
+uint32_t SIM5320FTPClient::get_upload_bandwidth() const
+{
+    return _put_bandwidth;
+}
+
+void SIM5320FTPClient::set_upload_bandwidth(uint32_t bandwidth)
+{
+    _put_bandwidth = bandwidth;
+}
+
+namespace sim5320 {
+/**
+ * Helper object to calculate digest of the data that is passed through a transfer callback.
+ */
+struct digest_callback_t {
+    Callback<ssize_t(uint8_t *, size_t)> data_callback;
+    SIM5320FTPClient::DigestType type;
+    MbedCRC<POLY_32BIT_ANSI, 32> crc;
+    uint32_t crc_value;
+    mbedtls_sha256_context sha256;
+
+    digest_callback_t(Callback<ssize_t(uint8_t *, size_t)> data_callback, SIM5320FTPClient::DigestType type)
+        : data_callback(data_callback)
+        , type(type)
+        , crc_value(0)
+    {
+        if (type == SIM5320FTPClient::DIGEST_SHA256) {
+            mbedtls_sha256_init(&sha256);
+            mbedtls_sha256_starts_ret(&sha256, 0);
+        } else {
+            crc.compute_partial_start(&crc_value);
+        }
+    }
+
+    ~digest_callback_t()
+    {
+        if (type == SIM5320FTPClient::DIGEST_SHA256) {
+            mbedtls_sha256_free(&sha256);
+        }
+    }
+
+    ssize_t process(uint8_t *data, size_t size)
+    {
+        ssize_t res = data_callback(data, size);
+        if (res > 0) {
+            if (type == SIM5320FTPClient::DIGEST_SHA256) {
+                mbedtls_sha256_update_ret(&sha256, data, res);
+            } else {
+                crc.compute_partial(data, res, &crc_value);
+            }
+        }
+        return res;
+    }
+
+    nsapi_error_t finish(uint8_t *value, const uint8_t *expected_value)
+    {
+        if (type == SIM5320FTPClient::DIGEST_SHA256) {
+            mbedtls_sha256_finish_ret(&sha256, value);
+        } else {
+            crc.compute_partial_stop(&crc_value);
+            value[0] = crc_value >> 24;
+            value[1] = crc_value >> 16;
+            value[2] = crc_value >> 8;
+            value[3] = crc_value;
+        }
+        if (expected_value && memcmp(value, expected_value, SIM5320FTPClient::get_digest_size(type)) != 0) {
+            tr_warning("Transfer digest mismatch");
+            return MBED_ERROR_INVALID_DATA_DETECTED;
+        }
+        return NSAPI_ERROR_OK;
+    }
+};
+}
+
+size_t SIM5320FTPClient::get_digest_size(SIM5320FTPClient::DigestType type)
+{
+    return type == DIGEST_SHA256 ? 32 : 4;
+}
+
+nsapi_error_t SIM5320FTPClient::put(const char *path, Callback<ssize_t(uint8_t *, size_t)> data_writer, SIM5320FTPClient::digest_t *digest, const uint8_t *expected_digest)
+{
+    if (digest == nullptr) {
+        return put(path, data_writer);
+    }
+    digest_callback_t digest_callback(data_writer, digest->type);
+    nsapi_error_t err = put(path, callback(&digest_callback, &digest_callback_t::process));
+    return err ? err : digest_callback.finish(digest->value, expected_digest);
+}
+
+nsapi_error_t SIM5320FTPClient::get(const char *path, Callback<ssize_t(uint8_t *, size_t)> data_reader, SIM5320FTPClient::digest_t *digest, const uint8_t *expected_digest)
+{
+    if (digest == nullptr) {
+        return get(path, data_reader);
+    }
+    digest_callback_t digest_callback(data_reader, digest->type);
+    nsapi_error_t err = get(path, callback(&digest_callback, &digest_callback_t::process));
+    return err ? err : digest_callback.finish(digest->value, expected_digest);
+}
+
 nsapi_error_t SIM5320FTPClient::put(const char *path, uint8_t *buf, size_t len)
 {
     buffer_reader_t buffer_reader(buf, len, 0);
-    return put(path, callback(&buffer_reader, &buffer_reader_t::read));
+    if (_encoder) {
+        return put(path, callback(&buffer_reader, &buffer_reader_t::read));
+    }
+    // note: data is already in memory, so double buffering isn't needed
+    return _put_impl(path, callback(&buffer_reader, &buffer_reader_t::read));
 }
 
 nsapi_error_t SIM5320FTPClient::get(const char *path, Callback<ssize_t(uint8_t *, size_t)> data_reader)
 {
+    if (_decoder) {
+        // decompress received data
+        // note: hold session lock, as codec state is shared between transfers
+        session_lock_t session_lock(this);
+        RETURN_IF_ERROR(session_lock.err);
+        _decoder->start(data_reader);
+        nsapi_error_t err = _get_data_impl(path, callback(_decoder, &LZSSDecoder::write), "GET");
+        return err ? err : _decoder->finish();
+    }
     return _get_data_impl(path, data_reader, "GET");
 }
 
-nsapi_error_t SIM5320FTPClient::download(const char *remote_path, const char *local_path)
+nsapi_error_t SIM5320FTPClient::get(const char *path, long offset, Callback<ssize_t(uint8_t *, size_t)> data_reader)
+{
+    if (offset < 0) {
+        return NSAPI_ERROR_PARAMETER;
+    }
+    if (_decoder) {
+        // compressed stream cannot be decoded from the middle
+        return offset == 0 ? get(path, data_reader) : NSAPI_ERROR_UNSUPPORTED;
+    }
+    return _get_data_impl(path, data_reader, "GET", offset);
+}
+
+nsapi_error_t SIM5320FTPClient::download(const char *remote_path, const char *local_path, SIM5320FTPClient::digest_t *digest, const uint8_t *expected_digest)
 {
     int err;
     int file;
@@ -634,7 +1851,7 @@ nsapi_error_t SIM5320FTPClient::download(const char *remote_path, const char *lo
         return MBED_ERROR_EIO;
     }
 
-    err = download(remote_path, file);
+    err = download(remote_path, file, digest, expected_digest);
 
     if (close(file)) {
         err = any_error(err, MBED_ERROR_EIO);
@@ -664,10 +1881,10 @@ struct cfile_download_callback_t {
 };
 }
 
-nsapi_error_t SIM5320FTPClient::download(const char *remote_path, FILE *local_file)
+nsapi_error_t SIM5320FTPClient::download(const char *remote_path, FILE *local_file, SIM5320FTPClient::digest_t *digest, const uint8_t *expected_digest)
 {
     cfile_download_callback_t donwload_callback(local_file);
-    return get(remote_path, callback(&donwload_callback, &cfile_download_callback_t::store));
+    return get(remote_path, callback(&donwload_callback, &cfile_download_callback_t::store), digest, expected_digest);
 }
 
 namespace sim5320 {
@@ -691,13 +1908,67 @@ struct file_download_callback_t {
 };
 }
 
-nsapi_error_t SIM5320FTPClient::download(const char *remote_path, int local_file)
+nsapi_error_t SIM5320FTPClient::download(const char *remote_path, int local_file, SIM5320FTPClient::digest_t *digest, const uint8_t *expected_digest)
 {
     file_download_callback_t donwload_callback(local_file);
-    return get(remote_path, callback(&donwload_callback, &file_download_callback_t::store));
+    return get(remote_path, callback(&donwload_callback, &file_download_callback_t::store), digest, expected_digest);
 }
 
-nsapi_error_t SIM5320FTPClient::upload(const char *local_path, const char *remote_path)
+nsapi_error_t SIM5320FTPClient::download_resume(const char *remote_path, const char *local_path)
+{
+    int err;
+    int file;
+    long remote_size;
+    off_t offset;
+
+    if (_decoder) {
+        // remote file size doesn't correspond to local one
+        return NSAPI_ERROR_UNSUPPORTED;
+    }
+
+    err = get_file_size(remote_path, remote_size);
+    if (err) {
+        return err;
+    }
+
+    file = open(local_path, O_WRONLY | O_CREAT);
+    if (file < 0) {
+        return MBED_ERROR_EIO;
+    }
+    offset = lseek(file, 0, SEEK_END);
+    if (offset < 0) {
+        close(file);
+        return MBED_ERROR_EIO;
+    }
+
+    if (remote_size >= 0 && offset > remote_size) {
+        // local file doesn't correspond to remote one, so download it again
+        tr_info("Local file is bigger than remote one. Download it again ...");
+        close(file);
+        file = open(local_path, O_WRONLY | O_CREAT | O_TRUNC);
+        if (file < 0) {
+            return MBED_ERROR_EIO;
+        }
+        offset = 0;
+    }
+
+    if (remote_size >= 0 && offset == remote_size && offset > 0) {
+        // file has been downloaded already
+        err = NSAPI_ERROR_OK;
+    } else {
+        tr_debug("Resume download from position %ld", (long)offset);
+        file_download_callback_t donwload_callback(file);
+        err = get(remote_path, (long)offset, callback(&donwload_callback, &file_download_callback_t::store));
+    }
+
+    if (close(file)) {
+        err = any_error(err, MBED_ERROR_EIO);
+    }
+
+    return err;
+}
+
+nsapi_error_t SIM5320FTPClient::upload(const char *local_path, const char *remote_path, SIM5320FTPClient::digest_t *digest, const uint8_t *expected_digest)
 {
     int err;
     int file;
@@ -707,7 +1978,7 @@ nsapi_error_t SIM5320FTPClient::upload(const char *local_path, const char *remot
         return MBED_ERROR_EIO;
     }
 
-    err = upload(file, remote_path);
+    err = upload(file, remote_path, digest, expected_digest);
 
     if (close(file)) {
         err = any_error(err, MBED_ERROR_EIO);
@@ -742,10 +2013,10 @@ struct cfile_upload_callback_t {
 };
 }
 
-nsapi_error_t SIM5320FTPClient::upload(FILE *local_file, const char *remote_path)
+nsapi_error_t SIM5320FTPClient::upload(FILE *local_file, const char *remote_path, SIM5320FTPClient::digest_t *digest, const uint8_t *expected_digest)
 {
     cfile_upload_callback_t upload_callback(local_file);
-    return put(remote_path, callback(&upload_callback, &cfile_upload_callback_t::fetch));
+    return put(remote_path, callback(&upload_callback, &cfile_upload_callback_t::fetch), digest, expected_digest);
 }
 
 namespace sim5320 {
@@ -770,21 +2041,210 @@ struct file_upload_callback_t {
 };
 }
 
-nsapi_error_t SIM5320FTPClient::upload(int local_file, const char *remote_path)
+nsapi_error_t SIM5320FTPClient::upload(int local_file, const char *remote_path, SIM5320FTPClient::digest_t *digest, const uint8_t *expected_digest)
 {
     file_upload_callback_t upload_callback(local_file);
-    return put(remote_path, callback(&upload_callback, &file_upload_callback_t::fetch));
+    return put(remote_path, callback(&upload_callback, &file_upload_callback_t::fetch), digest, expected_digest);
+}
+
+namespace sim5320 {
+/**
+ * Compact remote file description for directory synchronization.
+ */
+struct sync_remote_entry_t {
+    uint64_t name_hash;
+    int32_t size;
+    uint32_t mtime;
+};
+
+/**
+ * Calculate 64-bit FNV-1a hash of the file name.
+ *
+ * The 64-bit hash is used, as a name collision can cause skipping of the file upload.
+ */
+static uint64_t sync_name_hash(const char *name)
+{
+    uint64_t hash = 14695981039346656037ull;
+    while (*name != '\0') {
+        hash ^= (uint8_t)*name;
+        hash *= 1099511628211ull;
+        name++;
+    }
+    return hash;
 }
 
-static constexpr milliseconds_u32 FTP_GET_DATA_WAIT_TIMEOUT = 3s;
-#define FTP_GET_DATA_MAX_WAIT_DATA_ATTEMPTS 10
+/**
+ * Helper object to collect remote files for directory synchronization.
+ */
+struct sync_remote_collector_t {
+    sync_remote_entry_t *entries;
+    size_t max_entries;
+    size_t num_entries;
+
+    sync_remote_collector_t(sync_remote_entry_t *entries, size_t max_entries)
+        : entries(entries)
+        , max_entries(max_entries)
+        , num_entries(0)
+    {
+    }
 
-nsapi_error_t SIM5320FTPClient::_get_data_impl(const char *path, Callback<ssize_t(uint8_t *, size_t)> data_reader, const char *command)
+    void collect(const SIM5320FTPClient::dir_entry_view &entry)
+    {
+        if (entry.d_type == DT_DIR) {
+            return;
+        }
+        if (num_entries >= max_entries) {
+            // note: files that aren't remembered will be uploaded again
+            tr_warning("sync_dir: too many remote files. Skip \"%s\"", entry.name);
+            return;
+        }
+        sync_remote_entry_t &remote_entry = entries[num_entries++];
+        remote_entry.name_hash = sync_name_hash(entry.name);
+        remote_entry.size = entry.size;
+        remote_entry.mtime = entry.mtime;
+    }
+
+    const sync_remote_entry_t *find(const char *name) const
+    {
+        uint64_t name_hash = sync_name_hash(name);
+        for (size_t i = 0; i < num_entries; i++) {
+            if (entries[i].name_hash == name_hash) {
+                return &entries[i];
+            }
+        }
+        return nullptr;
+    }
+};
+}
+
+static bool sync_dir_is_changed(SIM5320FTPClient::SyncPolicy policy, const struct stat &local_stat, const sync_remote_entry_t *remote_entry)
+{
+    if (remote_entry == nullptr) {
+        return true;
+    }
+    switch (policy) {
+    case SIM5320FTPClient::SYNC_POLICY_MISSING:
+        return false;
+    case SIM5320FTPClient::SYNC_POLICY_SIZE:
+        return remote_entry->size < 0 || remote_entry->size != local_stat.st_size;
+    case SIM5320FTPClient::SYNC_POLICY_SIZE_MTIME:
+        if (remote_entry->size < 0 || remote_entry->size != local_stat.st_size) {
+            return true;
+        }
+        // compare modification time only if it's available
+        return local_stat.st_mtime > 0 && remote_entry->mtime > 0 && (uint32_t)local_stat.st_mtime > remote_entry->mtime;
+    default:
+        return true;
+    }
+}
+
+#define SYNC_DIR_PATH_BUF_LEN 256
+
+nsapi_error_t SIM5320FTPClient::sync_dir(const char *local_dir, const char *remote_dir, SIM5320FTPClient::SyncPolicy policy, SIM5320FTPClient::sync_summary_t *summary)
+{
+    int err;
+    sync_summary_t summary_tmp;
+    // note: allocate remote entries on heap, as upload and listdir frames are placed under this one
+    sync_remote_entry_t *remote_entries = nullptr;
+    sync_remote_collector_t remote_collector(nullptr, 0);
+    transfer_stats_t transfer_stats;
+    char local_path_buf[SYNC_DIR_PATH_BUF_LEN];
+    char remote_path_buf[SYNC_DIR_PATH_BUF_LEN];
+    size_t local_dir_len = strlen(local_dir);
+    size_t remote_dir_len = strlen(remote_dir);
+    struct stat local_stat;
+
+    if (summary == nullptr) {
+        summary = &summary_tmp;
+    }
+    memset(summary, 0, sizeof(sync_summary_t));
+    if (local_dir_len + 2 > SYNC_DIR_PATH_BUF_LEN || remote_dir_len + 2 > SYNC_DIR_PATH_BUF_LEN) {
+        return MBED_ERROR_INVALID_SIZE;
+    }
+
+    // read remote state
+    if (policy != SYNC_POLICY_ALL) {
+        remote_entries = new sync_remote_entry_t[MBED_CONF_SIM5320_DRIVER_FTP_SYNC_MAX_REMOTE_ENTRIES];
+        remote_collector.entries = remote_entries;
+        remote_collector.max_entries = MBED_CONF_SIM5320_DRIVER_FTP_SYNC_MAX_REMOTE_ENTRIES;
+        err = listdir(remote_dir, callback(&remote_collector, &sync_remote_collector_t::collect));
+        if (err) {
+            // remote directory probably doesn't exist
+            if (mkdir(remote_dir)) {
+                delete[] remote_entries;
+                return err;
+            }
+        }
+    }
+
+    DIR *dir = opendir(local_dir);
+    if (dir == nullptr) {
+        delete[] remote_entries;
+        return MBED_ERROR_EIO;
+    }
+    strcpy(local_path_buf, local_dir);
+    local_path_buf[local_dir_len] = '/';
+    strcpy(remote_path_buf, remote_dir);
+    remote_path_buf[remote_dir_len] = '/';
+
+    err = 0;
+    struct dirent *dir_entry;
+    while ((dir_entry = readdir(dir)) != nullptr) {
+        if (dir_entry->d_type == DT_DIR) {
+            continue;
+        }
+        size_t name_len = strlen(dir_entry->d_name);
+        if (local_dir_len + name_len + 2 > SYNC_DIR_PATH_BUF_LEN || remote_dir_len + name_len + 2 > SYNC_DIR_PATH_BUF_LEN) {
+            err = MBED_ERROR_INVALID_SIZE;
+            break;
+        }
+        strcpy(local_path_buf + local_dir_len + 1, dir_entry->d_name);
+        strcpy(remote_path_buf + remote_dir_len + 1, dir_entry->d_name);
+        if (stat(local_path_buf, &local_stat)) {
+            err = MBED_ERROR_EIO;
+            break;
+        }
+        if (!S_ISREG(local_stat.st_mode)) {
+            continue;
+        }
+        summary->files_checked++;
+
+        if (!sync_dir_is_changed(policy, local_stat, remote_collector.find(dir_entry->d_name))) {
+            continue;
+        }
+        tr_debug("sync_dir: upload \"%s\"", local_path_buf);
+        err = upload(local_path_buf, remote_path_buf);
+        if (err) {
+            break;
+        }
+        summary->files_uploaded++;
+        // note: transferred data size can differ from file size if compression is enabled
+        get_transfer_stats(transfer_stats);
+        summary->bytes_uploaded += transfer_stats.bytes_done;
+    }
+
+    if (closedir(dir)) {
+        err = any_error(err, MBED_ERROR_EIO);
+    }
+    delete[] remote_entries;
+    return err;
+}
+
+// maximal time without data before transfer is considered failed
+static constexpr milliseconds_u32 FTP_GET_DATA_TIMEOUT = 30s;
+// fallback cache polling periods, if data URC codes aren't processed in background
+static constexpr milliseconds_u32 FTP_GET_DATA_MIN_WAIT_PERIOD = 10ms;
+static constexpr milliseconds_u32 FTP_GET_DATA_MAX_WAIT_PERIOD = 500ms;
+
+nsapi_error_t SIM5320FTPClient::_get_data_impl(const char *path, Callback<ssize_t(uint8_t *, size_t)> data_reader, const char *command, long offset)
 {
     ssize_t callback_res = 0;
+    session_lock_t session_lock(this);
+    RETURN_IF_ERROR(session_lock.err);
     ATHandlerLocker locker(_at, FTP_RESPONSE_TIMEOUT);
 
     uint8_t *cache_buf = (uint8_t *)_get_buffer();
+    transfer_stats_tracker_t stats_tracker(this);
 
     // prepare commands
     const char *cmd_request;
@@ -802,19 +2262,26 @@ nsapi_error_t SIM5320FTPClient::_get_data_impl(const char *path, Callback<ssize_
         return NSAPI_ERROR_PARAMETER;
     }
 
+    // reset transfer notifications
+    _transfer_code = -1;
+    _transfer_flags.clear(FTP_TRANSFER_DATA_FLAG | FTP_TRANSFER_END_FLAG);
+
     // request to get file using cache
     int cftpsget_code = -1;
     ssize_t data_len;
     _at.cmd_start(cmd_request);
     _at.write_string(path); // file path
     if (add_rest_size) {
-        _at.write_int(0); // rest size
+        _at.write_int(offset); // rest size
     }
     _at.write_int(1); // use cache
     _at.cmd_stop_read_resp();
 
     // read data from cache
-    int wait_data_attempt_count = 0;
+    Timer no_data_timer;
+    milliseconds_u32 wait_period = FTP_GET_DATA_MIN_WAIT_PERIOD;
+    uint32_t transfer_flags;
+    no_data_timer.start();
     while (!_at.get_last_error()) {
         _at.cmd_start_stop("+CFTPSCACHERD", "");
         // there 3 possible responses
@@ -840,6 +2307,7 @@ nsapi_error_t SIM5320FTPClient::_get_data_impl(const char *path, Callback<ssize_
                 // process data
                 _at.read_bytes(cache_buf, data_len);
                 tr_debug("receive %d bytes", data_len);
+                stats_tracker.on_data(data_len);
 
                 // process data by callback
                 int processed_bytes = 0;
@@ -863,34 +2331,58 @@ nsapi_error_t SIM5320FTPClient::_get_data_impl(const char *path, Callback<ssize_
                 cftpsget_code = code < 0 ? 2 : code;
             }
         }
+        if (callback_res < 0) {
+            break;
+        }
+        // check if end of transmission code has been processed as URC
+        if (cftpsget_code < 0 && _transfer_code >= 0) {
+            cftpsget_code = _transfer_code;
+        }
 
         // as the operation can be long we should reset ATHanlder timeout
-        // TODO: check if it's better to release lock and invoke ThisThread::yield to
-        // allow other thread to use this driver.
         locker.reset_timeout();
 
-        if (cache_is_empty) {
-            if (cftpsget_code < 0) {
-                // wait data
-                wait_data_attempt_count++;
-                if (wait_data_attempt_count >= FTP_GET_DATA_MAX_WAIT_DATA_ATTEMPTS) {
-                    cftpsget_code = 2;
-                    break;
-                }
-                tr_debug("wait data ...");
-                ThisThread::sleep_for(FTP_GET_DATA_WAIT_TIMEOUT);
-            } else {
-                // end of transmission
-                tr_debug("Complete");
-                break;
+        if (!cache_is_empty) {
+            no_data_timer.reset();
+            wait_period = FTP_GET_DATA_MIN_WAIT_PERIOD;
+            if (_cooperative_mode) {
+                // allow other threads to use device between data blocks
+                locker.unlock();
+                ThisThread::yield();
+                locker.lock();
             }
+            continue;
+        }
+        if (cftpsget_code >= 0) {
+            // end of transmission
+            tr_debug("Complete");
+            break;
+        }
+        if (no_data_timer.elapsed_time() > FTP_GET_DATA_TIMEOUT) {
+            cftpsget_code = 2;
+            break;
+        }
+
+        // wait data notification, but release lock to allow other threads to use device
+        tr_debug("wait data ...");
+        stats_tracker.on_cache_empty();
+        locker.unlock();
+        transfer_flags = _transfer_flags.wait_any_for(FTP_TRANSFER_DATA_FLAG | FTP_TRANSFER_END_FLAG, wait_period);
+        locker.lock();
+        if (transfer_flags & osFlagsError) {
+            // there are no notifications, so increase polling period
+            wait_period = wait_period * 2 < FTP_GET_DATA_MAX_WAIT_PERIOD ? wait_period * 2 : FTP_GET_DATA_MAX_WAIT_PERIOD;
         } else {
-            wait_data_attempt_count = 0;
+            wait_period = FTP_GET_DATA_MIN_WAIT_PERIOD;
         }
+        // process URC codes, if they aren't processed in background
+        _at.process_oob();
     }
 
     if (cftpsget_code > 0) {
-        return convert_ftp_error_code(cftpsget_code);
+        int err = convert_ftp_error_code(cftpsget_code);
+        _on_session_error(err);
+        return err;
     }
 
     if (callback_res < 0) {
@@ -899,3 +2391,122 @@ nsapi_error_t SIM5320FTPClient::_get_data_impl(const char *path, Callback<ssize_
 
     return _at.get_last_error();
 }
+
+void SIM5320FTPClient::_urc_cftps_file()
+{
+    // end of the background transfer: "+CFTPSGETFILE: <code>" or "+CFTPSPUTFILE: <code>"
+    int code = _at.read_int();
+    nsapi_error_t err = convert_ftp_error_code(code < 0 ? 2 : code);
+    _modem_transfer_code = err;
+    _modem_transfer_pending = false;
+    _last_activity = Kernel::Clock::now();
+    _transfer_flags.set(FTP_MODEM_TRANSFER_END_FLAG);
+    if (_modem_transfer_cb) {
+        _modem_transfer_cb(err);
+    }
+}
+
+nsapi_error_t SIM5320FTPClient::_start_modem_transfer(const char *cmd, const char *remote_path, int modem_dir, Callback<void(nsapi_error_t)> done_cb)
+{
+    int err;
+    session_lock_t session_lock(this);
+    RETURN_IF_ERROR(session_lock.err);
+    ATHandlerLocker locker(_at, FTP_RESPONSE_TIMEOUT);
+
+    _modem_transfer_code = NSAPI_ERROR_OK;
+    _modem_transfer_pending = true;
+    _modem_transfer_cb = done_cb;
+    _transfer_flags.clear(FTP_MODEM_TRANSFER_END_FLAG);
+
+    // note: command returns "OK" immediately, and result is reported by URC code
+    _at.cmd_start_stop(cmd, "=", "%s%d", remote_path, modem_dir);
+    err = read_fuzzy_ftp_response(_at, false, false, cmd);
+    if (err) {
+        _modem_transfer_code = err;
+        _modem_transfer_pending = false;
+        _modem_transfer_cb = nullptr;
+    }
+    return err;
+}
+
+nsapi_error_t SIM5320FTPClient::fetch_to_modem(const char *remote_path, SIM5320FTPClient::ModemDir modem_dir, Callback<void(nsapi_error_t)> done_cb)
+{
+    return _start_modem_transfer("+CFTPSGETFILE", remote_path, modem_dir, done_cb);
+}
+
+nsapi_error_t SIM5320FTPClient::push_from_modem(const char *remote_path, SIM5320FTPClient::ModemDir modem_dir, Callback<void(nsapi_error_t)> done_cb)
+{
+    return _start_modem_transfer("+CFTPSPUTFILE", remote_path, modem_dir, done_cb);
+}
+
+// URC polling period, if URC codes aren't processed in background
+static constexpr milliseconds_u32 FTP_MODEM_TRANSFER_WAIT_PERIOD = 500ms;
+
+nsapi_error_t SIM5320FTPClient::wait_modem_transfer(milliseconds_u32 timeout)
+{
+    Timer timer;
+    timer.start();
+    while (_modem_transfer_pending) {
+        if (timer.elapsed_time() >= timeout) {
+            return NSAPI_ERROR_TIMEOUT;
+        }
+        _transfer_flags.wait_any_for(FTP_MODEM_TRANSFER_END_FLAG, FTP_MODEM_TRANSFER_WAIT_PERIOD, false);
+        if (_modem_transfer_pending) {
+            // process URC codes, if they aren't processed in background
+            _at.lock();
+            _at.process_oob();
+            _at.unlock();
+        }
+    }
+    return _modem_transfer_code;
+}
+
+// maximal block size that is requested by "AT+CFTRANTX" command
+#define MODEM_FILE_READ_BLOCK_SIZE 1024
+
+nsapi_error_t SIM5320FTPClient::read_modem_file(const char *modem_path, Callback<ssize_t(uint8_t *, size_t)> data_reader, long offset)
+{
+    ssize_t callback_res = 0;
+    ssize_t block_size;
+    ATHandlerLocker locker(_at, FTP_RESPONSE_TIMEOUT);
+    uint8_t *buf = (uint8_t *)_get_buffer();
+    MBED_STATIC_ASSERT(MODEM_FILE_READ_BLOCK_SIZE <= BUFFER_SIZE, "Modem file block is bigger than buffer");
+
+    while (true) {
+        // request next file block
+        block_size = at_read_modem_file_block(_at, modem_path, offset, buf, MODEM_FILE_READ_BLOCK_SIZE, false);
+        if (block_size < 0) {
+            return block_size;
+        }
+        // process data by callback
+        ssize_t processed_bytes = 0;
+        while (processed_bytes < block_size) {
+            callback_res = data_reader(buf + processed_bytes, block_size - processed_bytes);
+            if (callback_res < 0) {
+                return callback_res;
+            }
+            processed_bytes += callback_res;
+        }
+        offset += block_size;
+        if (block_size < MODEM_FILE_READ_BLOCK_SIZE) {
+            // end of file
+            break;
+        }
+
+        if (_cooperative_mode) {
+            // allow other threads to use device between data blocks
+            locker.unlock();
+            ThisThread::yield();
+            locker.lock();
+        } else {
+            locker.reset_timeout();
+        }
+    }
+
+    return NSAPI_ERROR_OK;
+}
+
+nsapi_error_t SIM5320FTPClient::delete_modem_file(const char *modem_path)
+{
+    return _at.at_cmd_discard("+FSDEL", "=", "%s", modem_path);
+}
@@ -0,0 +1,751 @@
+#include "sim5320_FileSystem.h"
+
+#include <errno.h>
+#include <string.h>
+
+#include "sim5320_trace.h"
+#include "sim5320_utils.h"
+
+using mbed::chrono::milliseconds_u32;
+using namespace sim5320;
+
+static constexpr milliseconds_u32 FS_RESPONSE_TIMEOUT = 16s;
+
+constexpr milliseconds_u32 SIM5320FileSystem::FTP_TRANSFER_TIMEOUT;
+
+namespace sim5320 {
+/**
+ * Opened file state.
+ */
+struct fs_file_state_t {
+    char modem_path[SIM5320FileSystem::PATH_MAX_LEN];
+    int flags;
+    off_t pos;
+    off_t size;
+
+    // write-back buffer with full file content (only for writable files)
+    uint8_t *data;
+    size_t capacity;
+    bool dirty;
+
+    bool is_writable() const
+    {
+        return (flags & O_ACCMODE) != O_RDONLY;
+    }
+
+    int reserve(size_t new_size)
+    {
+        if (new_size <= capacity) {
+            return 0;
+        }
+        if (new_size > SIM5320FileSystem::MAX_WRITE_FILE_SIZE) {
+            return -EFBIG;
+        }
+        size_t new_capacity = capacity ? capacity : 256;
+        while (new_capacity < new_size) {
+            new_capacity *= 2;
+        }
+        if (new_capacity > SIM5320FileSystem::MAX_WRITE_FILE_SIZE) {
+            new_capacity = SIM5320FileSystem::MAX_WRITE_FILE_SIZE;
+        }
+        uint8_t *new_data = new uint8_t[new_capacity];
+        if (data) {
+            memcpy(new_data, data, size);
+            delete[] data;
+        }
+        data = new_data;
+        capacity = new_capacity;
+        return 0;
+    }
+};
+
+/**
+ * Opened directory state.
+ *
+ * The directory content is read at once, and entries are stored as "<d_type><name>\0" sequence.
+ */
+struct fs_dir_state_t {
+    char *data;
+    size_t len;
+    size_t capacity;
+    size_t pos;
+    size_t index;
+    size_t num_entries;
+
+    int add(char d_type, const char *name)
+    {
+        size_t entry_len = strlen(name) + 2;
+        if (len + entry_len > capacity) {
+            size_t new_capacity = capacity ? capacity * 2 : 128;
+            while (new_capacity < len + entry_len) {
+                new_capacity *= 2;
+            }
+            char *new_data = new char[new_capacity];
+            if (data) {
+                memcpy(new_data, data, len);
+                delete[] data;
+            }
+            data = new_data;
+            capacity = new_capacity;
+        }
+        data[len] = d_type;
+        strcpy(data + len + 1, name);
+        len += entry_len;
+        num_entries++;
+        return 0;
+    }
+};
+}
+
+static const char *const MODEM_DIR_ROOTS[] = { "", "C:/", "D:/" };
+
+SIM5320FileSystem::SIM5320FileSystem(ATHandler &at, const char *name, SIM5320FTPClient::ModemDir modem_dir)
+    : FileSystem(name)
+    , _at(at)
+    , _modem_dir(modem_dir)
+    , _mounted(false)
+    , _cache_offset(0)
+    , _cache_len(0)
+    , _cache_valid(false)
+{
+    _cache_path[0] = '\0';
+}
+
+SIM5320FileSystem::~SIM5320FileSystem()
+{
+}
+
+int SIM5320FileSystem::_build_modem_path(char *modem_path, const char *path)
+{
+    const char *root = MODEM_DIR_ROOTS[_modem_dir];
+    size_t root_len = strlen(root);
+
+    while (*path == '/') {
+        path++;
+    }
+    size_t path_len = strlen(path);
+    while (path_len > 0 && path[path_len - 1] == '/') {
+        path_len--;
+    }
+    if (root_len + path_len + 1 > PATH_MAX_LEN) {
+        return -ENAMETOOLONG;
+    }
+    memcpy(modem_path, root, root_len);
+    memcpy(modem_path + root_len, path, path_len);
+    modem_path[root_len + path_len] = '\0';
+    return 0;
+}
+
+void SIM5320FileSystem::_invalidate_cache()
+{
+    _cache_valid = false;
+}
+
+bool SIM5320FileSystem::_is_cached(const char *modem_path)
+{
+    return _cache_valid && strcmp(_cache_path, modem_path) == 0;
+}
+
+int SIM5320FileSystem::_read_attributes(const char *modem_path, off_t &size)
+{
+    // response format:
+    // +FSATTRI: <file_size>, <create_date>
+    ATHandlerLocker locker(_at, FS_RESPONSE_TIMEOUT);
+    _at.cmd_start_stop("+FSATTRI", "=", "%s", modem_path);
+    _at.resp_start("+FSATTRI:");
+    int value = _at.read_int();
+    _at.resp_stop();
+    if (_at.get_last_error() || value < 0) {
+        return -ENOENT;
+    }
+    size = value;
+    return 0;
+}
+
+int SIM5320FileSystem::_change_dir(const char *modem_path)
+{
+    nsapi_error_t err = _at.at_cmd_discard("+FSCD", "=", "%s", modem_path);
+    return err ? -ENOENT : 0;
+}
+
+int SIM5320FileSystem::_read_block(const char *modem_path, off_t offset, uint8_t *buf, size_t size)
+{
+    ATHandlerLocker locker(_at, FS_RESPONSE_TIMEOUT);
+    ssize_t res = at_read_modem_file_block(_at, modem_path, offset, buf, size, false);
+    return res < 0 ? -EIO : res;
+}
+
+int SIM5320FileSystem::_write_file(const char *modem_path, const uint8_t *data, size_t size)
+{
+    off_t current_size;
+    if (size == 0) {
+        // note: sim5320 doesn't allow to create empty files, so an empty file is represented by its absence
+        if (_read_attributes(modem_path, current_size)) {
+            return 0;
+        }
+        return _at.at_cmd_discard("+FSDEL", "=", "%s", modem_path) ? -EIO : 0;
+    }
+    // note: the file is rewritten completely
+    ATHandlerLocker locker(_at, FS_RESPONSE_TIMEOUT);
+    _at.cmd_start_stop("+CFTRANRX", "=", "%s%d", modem_path, (int)size);
+    _at.resp_start(">", true);
+    _at.write_bytes(data, size);
+    _at.resp_start();
+    _at.resp_stop();
+    return _at.get_last_error() ? -EIO : 0;
+}
+
+int SIM5320FileSystem::mount(BlockDevice *bd)
+{
+    ScopedLock<Mutex> lock(_mutex);
+    // check that storage is available
+    char modem_path[PATH_MAX_LEN];
+    _build_modem_path(modem_path, "");
+    int err = _change_dir(modem_path);
+    if (err) {
+        return -ENODEV;
+    }
+    _invalidate_cache();
+    _mounted = true;
+    return 0;
+}
+
+int SIM5320FileSystem::unmount()
+{
+    ScopedLock<Mutex> lock(_mutex);
+    _invalidate_cache();
+    _mounted = false;
+    return 0;
+}
+
+#define RETURN_IF_NOT_MOUNTED()  \
+    if (!_mounted) {             \
+        return -ENODEV;          \
+    }
+
+#define RETURN_IF_ERROR(expr) \
+    {                         \
+        int err = expr;       \
+        if (err) {            \
+            return err;       \
+        }                     \
+    }
+
+int SIM5320FileSystem::remove(const char *path)
+{
+    ScopedLock<Mutex> lock(_mutex);
+    RETURN_IF_NOT_MOUNTED();
+    char modem_path[PATH_MAX_LEN];
+    off_t size;
+    nsapi_error_t err;
+
+    RETURN_IF_ERROR(_build_modem_path(modem_path, path));
+    _invalidate_cache();
+    if (_read_attributes(modem_path, size) == 0) {
+        err = _at.at_cmd_discard("+FSDEL", "=", "%s", modem_path);
+    } else {
+        err = _at.at_cmd_discard("+FSRMDIR", "=", "%s", modem_path);
+        if (err) {
+            // directory doesn't exist or isn't empty
+            return _change_dir(modem_path) ? -ENOENT : -ENOTEMPTY;
+        }
+    }
+    return err ? -EIO : 0;
+}
+
+int SIM5320FileSystem::rename(const char *path, const char *newpath)
+{
+    ScopedLock<Mutex> lock(_mutex);
+    RETURN_IF_NOT_MOUNTED();
+    char modem_path[PATH_MAX_LEN];
+    char new_modem_path[PATH_MAX_LEN];
+
+    RETURN_IF_ERROR(_build_modem_path(modem_path, path));
+    RETURN_IF_ERROR(_build_modem_path(new_modem_path, newpath));
+    _invalidate_cache();
+    nsapi_error_t err = _at.at_cmd_discard("+FSRENAME", "=", "%s%s", modem_path, new_modem_path);
+    return err ? -EIO : 0;
+}
+
+int SIM5320FileSystem::stat(const char *path, struct stat *st)
+{
+    ScopedLock<Mutex> lock(_mutex);
+    RETURN_IF_NOT_MOUNTED();
+    char modem_path[PATH_MAX_LEN];
+    off_t size;
+
+    RETURN_IF_ERROR(_build_modem_path(modem_path, path));
+    memset(st, 0, sizeof(struct stat));
+    if (_read_attributes(modem_path, size) == 0) {
+        st->st_mode = S_IFREG | S_IRWXU | S_IRWXG | S_IRWXO;
+        st->st_size = size;
+    } else if (_change_dir(modem_path) == 0) {
+        st->st_mode = S_IFDIR | S_IRWXU | S_IRWXG | S_IRWXO;
+    } else {
+        return -ENOENT;
+    }
+    return 0;
+}
+
+int SIM5320FileSystem::mkdir(const char *path, mode_t mode)
+{
+    ScopedLock<Mutex> lock(_mutex);
+    RETURN_IF_NOT_MOUNTED();
+    char modem_path[PATH_MAX_LEN];
+
+    RETURN_IF_ERROR(_build_modem_path(modem_path, path));
+    if (_change_dir(modem_path) == 0) {
+        return -EEXIST;
+    }
+    nsapi_error_t err = _at.at_cmd_discard("+FSMKDIR", "=", "%s", modem_path);
+    return err ? -EIO : 0;
+}
+
+int SIM5320FileSystem::statvfs(const char *path, struct statvfs *buf)
+{
+    ScopedLock<Mutex> lock(_mutex);
+    RETURN_IF_NOT_MOUNTED();
+    char drive_info[24];
+    long long total = -1;
+    long long used = -1;
+    char drive = MODEM_DIR_ROOTS[_modem_dir][0];
+
+    // response format:
+    // +FSMEM: C:(<total>, <used>)[, D:(<total>, <used>)]
+    ATHandlerLocker locker(_at, FS_RESPONSE_TIMEOUT);
+    _at.cmd_start_stop("+FSMEM", "");
+    _at.resp_start("+FSMEM:");
+    while (_at.read_string(drive_info, sizeof(drive_info)) > 0) {
+        const char *total_str = strchr(drive_info, '(');
+        if (total_str == nullptr) {
+            continue;
+        }
+        bool target_drive = strchr(drive_info, drive) != nullptr;
+        if (_at.read_string(drive_info, sizeof(drive_info)) <= 0) {
+            break;
+        }
+        if (target_drive) {
+            total = strtoll(total_str + 1, nullptr, 10);
+            used = strtoll(drive_info, nullptr, 10);
+            break;
+        }
+    }
+    _at.resp_stop();
+    if (_at.get_last_error() || total < 0 || used < 0) {
+        return -EIO;
+    }
+
+    memset(buf, 0, sizeof(struct statvfs));
+    buf->f_bsize = READ_BLOCK_SIZE;
+    buf->f_frsize = READ_BLOCK_SIZE;
+    buf->f_blocks = total / READ_BLOCK_SIZE;
+    buf->f_bfree = (total - used) / READ_BLOCK_SIZE;
+    buf->f_bavail = buf->f_bfree;
+    buf->f_namemax = PATH_MAX_LEN - 1;
+    return 0;
+}
+
+int SIM5320FileSystem::ftp_download(SIM5320FTPClient *ftp_client, const char *remote_path, milliseconds_u32 timeout)
+{
+    ScopedLock<Mutex> lock(_mutex);
+    RETURN_IF_NOT_MOUNTED();
+    _invalidate_cache();
+    if (ftp_client->fetch_to_modem(remote_path, _modem_dir)) {
+        return -EIO;
+    }
+    nsapi_error_t err = ftp_client->wait_modem_transfer(timeout);
+    if (err == NSAPI_ERROR_TIMEOUT) {
+        return -ETIMEDOUT;
+    }
+    return err ? -EIO : 0;
+}
+
+int SIM5320FileSystem::ftp_upload(SIM5320FTPClient *ftp_client, const char *remote_path, milliseconds_u32 timeout)
+{
+    ScopedLock<Mutex> lock(_mutex);
+    RETURN_IF_NOT_MOUNTED();
+    if (ftp_client->push_from_modem(remote_path, _modem_dir)) {
+        return -EIO;
+    }
+    nsapi_error_t err = ftp_client->wait_modem_transfer(timeout);
+    if (err == NSAPI_ERROR_TIMEOUT) {
+        return -ETIMEDOUT;
+    }
+    return err ? -EIO : 0;
+}
+
+/**
+ * File operations
+ */
+
+int SIM5320FileSystem::file_open(fs_file_t *file, const char *path, int flags)
+{
+    ScopedLock<Mutex> lock(_mutex);
+    RETURN_IF_NOT_MOUNTED();
+    int err;
+    off_t size = 0;
+    sim5320::fs_file_state_t *f = new sim5320::fs_file_state_t();
+    memset(f, 0, sizeof(sim5320::fs_file_state_t));
+    f->flags = flags;
+
+    err = _build_modem_path(f->modem_path, path);
+    if (err) {
+        delete f;
+        return err;
+    }
+
+    bool exists = _read_attributes(f->modem_path, size) == 0;
+    if (!exists && !(flags & O_CREAT)) {
+        delete f;
+        return -ENOENT;
+    }
+    if (exists && (flags & O_CREAT) && (flags & O_EXCL)) {
+        delete f;
+        return -EEXIST;
+    }
+    if (exists && (flags & O_TRUNC)) {
+        size = 0;
+        f->dirty = true;
+    }
+    if (!exists) {
+        f->dirty = true;
+    }
+    f->size = size;
+
+    if (f->is_writable() && size > 0) {
+        // load current content into write-back buffer
+        err = f->reserve(size);
+        for (off_t offset = 0; !err && offset < size;) {
+            size_t block_size = READ_BLOCK_SIZE;
+            if ((off_t)block_size > size - offset) {
+                block_size = size - offset;
+            }
+            int res = _read_block(f->modem_path, offset, f->data + offset, block_size);
+            if (res <= 0) {
+                err = res < 0 ? res : -EIO;
+            }
+            offset += res;
+        }
+        if (err) {
+            delete[] f->data;
+            delete f;
+            return err;
+        }
+    }
+
+    *file = f;
+    return 0;
+}
+
+int SIM5320FileSystem::file_close(fs_file_t file)
+{
+    int err = file_sync(file);
+    sim5320::fs_file_state_t *f = (sim5320::fs_file_state_t *)file;
+    delete[] f->data;
+    delete f;
+    return err;
+}
+
+ssize_t SIM5320FileSystem::file_read(fs_file_t file, void *buffer, size_t size)
+{
+    ScopedLock<Mutex> lock(_mutex);
+    sim5320::fs_file_state_t *f = (sim5320::fs_file_state_t *)file;
+    uint8_t *buf = (uint8_t *)buffer;
+    size_t read_len = 0;
+
+    if ((f->flags & O_ACCMODE) == O_WRONLY) {
+        return -EBADF;
+    }
+    if (f->pos >= f->size) {
+        return 0;
+    }
+    if ((off_t)size > f->size - f->pos) {
+        size = f->size - f->pos;
+    }
+
+    if (f->data) {
+        // file content is kept in the write-back buffer
+        memcpy(buf, f->data + f->pos, size);
+        f->pos += size;
+        return size;
+    }
+
+    while (read_len < size) {
+        if (!_is_cached(f->modem_path) || f->pos < _cache_offset || f->pos >= _cache_offset + (off_t)_cache_len) {
+            // read ahead next block
+            int res = _read_block(f->modem_path, f->pos, _cache_buf, READ_BLOCK_SIZE);
+            if (res < 0) {
+                _invalidate_cache();
+                return read_len > 0 ? (ssize_t)read_len : res;
+            } else if (res == 0) {
+                break;
+            }
+            strcpy(_cache_path, f->modem_path);
+            _cache_offset = f->pos;
+            _cache_len = res;
+            _cache_valid = true;
+        }
+        size_t cache_pos = f->pos - _cache_offset;
+        size_t chunk_len = _cache_len - cache_pos;
+        if (chunk_len > size - read_len) {
+            chunk_len = size - read_len;
+        }
+        memcpy(buf + read_len, _cache_buf + cache_pos, chunk_len);
+        read_len += chunk_len;
+        f->pos += chunk_len;
+    }
+    return read_len;
+}
+
+ssize_t SIM5320FileSystem::file_write(fs_file_t file, const void *buffer, size_t size)
+{
+    ScopedLock<Mutex> lock(_mutex);
+    sim5320::fs_file_state_t *f = (sim5320::fs_file_state_t *)file;
+
+    if (!f->is_writable()) {
+        return -EBADF;
+    }
+    if (f->flags & O_APPEND) {
+        f->pos = f->size;
+    }
+    off_t end_pos = f->pos + size;
+    RETURN_IF_ERROR(f->reserve(end_pos));
+    if (f->pos > f->size) {
+        // fill gap
+        memset(f->data + f->size, 0, f->pos - f->size);
+    }
+    memcpy(f->data + f->pos, buffer, size);
+    f->pos = end_pos;
+    if (end_pos > f->size) {
+        f->size = end_pos;
+    }
+    f->dirty = true;
+    return size;
+}
+
+int SIM5320FileSystem::file_sync(fs_file_t file)
+{
+    ScopedLock<Mutex> lock(_mutex);
+    sim5320::fs_file_state_t *f = (sim5320::fs_file_state_t *)file;
+
+    if (!f->dirty) {
+        return 0;
+    }
+    if (_is_cached(f->modem_path)) {
+        _invalidate_cache();
+    }
+    RETURN_IF_ERROR(_write_file(f->modem_path, f->data, f->size));
+    f->dirty = false;
+    return 0;
+}
+
+off_t SIM5320FileSystem::file_seek(fs_file_t file, off_t offset, int whence)
+{
+    ScopedLock<Mutex> lock(_mutex);
+    sim5320::fs_file_state_t *f = (sim5320::fs_file_state_t *)file;
+    off_t pos;
+
+    switch (whence) {
+        case SEEK_SET:
+            pos = offset;
+            break;
+        case SEEK_CUR:
+            pos = f->pos + offset;
+            break;
+        case SEEK_END:
+            pos = f->size + offset;
+            break;
+        default:
+            return -EINVAL;
+    }
+    if (pos < 0) {
+        return -EINVAL;
+    }
+    f->pos = pos;
+    return pos;
+}
+
+off_t SIM5320FileSystem::file_tell(fs_file_t file)
+{
+    ScopedLock<Mutex> lock(_mutex);
+    return ((sim5320::fs_file_state_t *)file)->pos;
+}
+
+off_t SIM5320FileSystem::file_size(fs_file_t file)
+{
+    ScopedLock<Mutex> lock(_mutex);
+    return ((sim5320::fs_file_state_t *)file)->size;
+}
+
+int SIM5320FileSystem::file_truncate(fs_file_t file, off_t length)
+{
+    ScopedLock<Mutex> lock(_mutex);
+    sim5320::fs_file_state_t *f = (sim5320::fs_file_state_t *)file;
+
+    if (!f->is_writable()) {
+        return -EBADF;
+    }
+    if (length < 0) {
+        return -EINVAL;
+    }
+    RETURN_IF_ERROR(f->reserve(length));
+    if (length > f->size) {
+        memset(f->data + f->size, 0, length - f->size);
+    }
+    f->size = length;
+    f->dirty = true;
+    return 0;
+}
+
+/**
+ * Directory operations
+ */
+
+namespace sim5320 {
+/**
+ * Helper parser of the "AT+FSLS" response.
+ *
+ * Response format:
+ *
+ * +FSLS: SUBDIRECTORIES:
+ * <dir_name_1>
+ * <dir_name_2>
+ *
+ * +FSLS: FILES:
+ * <file_name_1>
+ * <file_name_2>
+ *
+ * OK
+ */
+struct fs_dir_listing_parser_t {
+    static const size_t LINE_BUF_SIZE = 128;
+
+    sim5320::fs_dir_state_t *dir;
+    char d_type;
+    char line[LINE_BUF_SIZE];
+    int err;
+
+    fs_dir_listing_parser_t(sim5320::fs_dir_state_t *dir)
+        : dir(dir)
+        , d_type(DT_UNKNOWN)
+        , err(0)
+    {
+    }
+
+    /**
+     * Process section header (" SUBDIRECTORIES:" or " FILES:") or a name from the ::line buffer.
+     */
+    void process_line()
+    {
+        const char *name = line;
+        while (*name == ' ') {
+            name++;
+        }
+        if (strcmp(name, "SUBDIRECTORIES:") == 0) {
+            d_type = DT_DIR;
+        } else if (strcmp(name, "FILES:") == 0) {
+            d_type = DT_REG;
+        } else if (*name != '\0' && d_type != DT_UNKNOWN && !err) {
+            err = dir->add(d_type, name);
+        }
+    }
+};
+}
+
+int SIM5320FileSystem::dir_open(fs_dir_t *dir, const char *path)
+{
+    ScopedLock<Mutex> lock(_mutex);
+    RETURN_IF_NOT_MOUNTED();
+    char modem_path[PATH_MAX_LEN];
+    ssize_t line_len;
+
+    RETURN_IF_ERROR(_build_modem_path(modem_path, path));
+    sim5320::fs_dir_state_t *d = new sim5320::fs_dir_state_t();
+    memset(d, 0, sizeof(sim5320::fs_dir_state_t));
+    fs_dir_listing_parser_t parser(d);
+
+    ATHandlerLocker locker(_at, FS_RESPONSE_TIMEOUT);
+    // note: "AT+FSLS" lists current directory
+    _at.cmd_start_stop("+FSCD", "=", "%s", modem_path);
+    _at.resp_start();
+    _at.resp_stop();
+    if (_at.get_last_error()) {
+        delete d;
+        return -ENOENT;
+    }
+    _at.cmd_start_stop("+FSLS", "");
+    _at.resp_start("+FSLS:");
+    // names can contain commas, so don't split them
+    _at.set_delimiter('\0');
+    while (_at.info_resp()) {
+        // read section header
+        line_len = _at.read_string(parser.line, sizeof(parser.line));
+        // read names line by line till the empty line at the section end:
+        // information response stop tag is "\r\n", so reset it before each line
+        while (line_len > 0) {
+            parser.process_line();
+            _at.set_stop_tag("\r\n");
+            line_len = _at.read_string(parser.line, sizeof(parser.line));
+        }
+    }
+    _at.set_default_delimiter();
+    _at.resp_stop();
+
+    if (_at.get_last_error() || parser.err) {
+        delete[] d->data;
+        delete d;
+        return parser.err ? parser.err : -EIO;
+    }
+    *dir = d;
+    return 0;
+}
+
+int SIM5320FileSystem::dir_close(fs_dir_t dir)
+{
+    sim5320::fs_dir_state_t *d = (sim5320::fs_dir_state_t *)dir;
+    delete[] d->data;
+    delete d;
+    return 0;
+}
+
+ssize_t SIM5320FileSystem::dir_read(fs_dir_t dir, struct dirent *ent)
+{
+    sim5320::fs_dir_state_t *d = (sim5320::fs_dir_state_t *)dir;
+    if (d->pos >= d->len) {
+        return 0;
+    }
+    const char *entry = d->data + d->pos;
+    ent->d_type = entry[0];
+    strncpy(ent->d_name, entry + 1, sizeof(ent->d_name) - 1);
+    ent->d_name[sizeof(ent->d_name) - 1] = '\0';
+    d->pos += strlen(entry + 1) + 2;
+    d->index++;
+    return 1;
+}
+
+void SIM5320FileSystem::dir_seek(fs_dir_t dir, off_t offset)
+{
+    sim5320::fs_dir_state_t *d = (sim5320::fs_dir_state_t *)dir;
+    dir_rewind(dir);
+    while ((off_t)d->index < offset && d->pos < d->len) {
+        d->pos += strlen(d->data + d->pos + 1) + 2;
+        d->index++;
+    }
+}
+
+off_t SIM5320FileSystem::dir_tell(fs_dir_t dir)
+{
+    return ((sim5320::fs_dir_state_t *)dir)->index;
+}
+
+void SIM5320FileSystem::dir_rewind(fs_dir_t dir)
+{
+    sim5320::fs_dir_state_t *d = (sim5320::fs_dir_state_t *)dir;
+    d->pos = 0;
+    d->index = 0;
+}
+
+size_t SIM5320FileSystem::dir_size(fs_dir_t dir)
+{
+    return ((sim5320::fs_dir_state_t *)dir)->num_entries;
+}
@@ -0,0 +1,292 @@
+#include "sim5320_LZSSCodec.h"
+
+#include <string.h>
+
+using namespace sim5320;
+
+MBED_STATIC_ASSERT((LZSSCodec::WINDOW_SIZE & (LZSSCodec::WINDOW_SIZE - 1)) == 0, "Compression window size should be power of 2");
+MBED_STATIC_ASSERT(LZSSCodec::WINDOW_SIZE >= 64 && LZSSCodec::WINDOW_SIZE <= LZSSCodec::MAX_OFFSET, "Compression window size should be in range 64 - 4096");
+
+/**
+ * Encoder
+ */
+
+LZSSEncoder::LZSSEncoder()
+{
+    start(nullptr);
+}
+
+LZSSEncoder::~LZSSEncoder()
+{
+}
+
+void LZSSEncoder::start(Callback<ssize_t(uint8_t *, size_t)> source)
+{
+    _source = source;
+    _source_error = 0;
+    _source_eof = false;
+    _buf_base = 0;
+    _pos = 0;
+    _end = 0;
+    _group_len = 0;
+    _group_pos = 0;
+    // note: stale hash entries are safe, as match candidates are always compared with current data
+    memset(_head, 0, sizeof(_head));
+    memset(_prev, 0, sizeof(_prev));
+}
+
+int LZSSEncoder::_fill()
+{
+    while (_end - _pos < MAX_MATCH && !_source_eof) {
+        if (_end == BUF_SIZE) {
+            // drop data that is out of window
+            size_t shift = _pos - WINDOW_SIZE;
+            memmove(_buf, _buf + shift, _end - shift);
+            _buf_base += shift;
+            _pos -= shift;
+            _end -= shift;
+        }
+        ssize_t res = _source(_buf + _end, BUF_SIZE - _end);
+        if (res < 0) {
+            _source_error = res;
+            return res;
+        } else if (res == 0) {
+            _source_eof = true;
+        } else if ((size_t)res > BUF_SIZE - _end) {
+            _source_error = MBED_ERROR_INVALID_SIZE;
+            return _source_error;
+        }
+        _end += res;
+    }
+    return 0;
+}
+
+static inline uint8_t lzss_hash(const uint8_t *data)
+{
+    return (uint8_t)((data[0] << 5) ^ (data[1] << 2) ^ data[2] ^ (data[0] >> 3));
+}
+
+void LZSSEncoder::_insert_hash(size_t pos)
+{
+    if (_end - pos < MIN_MATCH) {
+        return;
+    }
+    uint16_t stream_pos = (uint16_t)(_buf_base + pos);
+    uint8_t hash = lzss_hash(_buf + pos);
+    _prev[stream_pos & (WINDOW_SIZE - 1)] = _head[hash];
+    _head[hash] = stream_pos;
+}
+
+size_t LZSSEncoder::_find_match(size_t &distance)
+{
+    size_t max_len = _end - _pos;
+    if (max_len < MIN_MATCH) {
+        return 0;
+    }
+    if (max_len > MAX_MATCH) {
+        max_len = MAX_MATCH;
+    }
+    uint32_t stream_pos = _buf_base + _pos;
+    size_t max_distance = stream_pos < WINDOW_SIZE ? stream_pos : WINDOW_SIZE;
+    size_t best_len = 0;
+
+    uint16_t candidate = _head[lzss_hash(_buf + _pos)];
+    for (int depth = 0; depth < MAX_CHAIN_DEPTH; depth++) {
+        size_t candidate_distance = (uint16_t)((uint16_t)stream_pos - candidate);
+        if (candidate_distance == 0 || candidate_distance > max_distance) {
+            break;
+        }
+        const uint8_t *cur = _buf + _pos;
+        const uint8_t *ref = cur - candidate_distance;
+        size_t len = 0;
+        while (len < max_len && cur[len] == ref[len]) {
+            len++;
+        }
+        if (len > best_len) {
+            best_len = len;
+            distance = candidate_distance;
+            if (len == max_len) {
+                break;
+            }
+        }
+        candidate = _prev[candidate & (WINDOW_SIZE - 1)];
+    }
+
+    return best_len >= MIN_MATCH ? best_len : 0;
+}
+
+int LZSSEncoder::_encode_group()
+{
+    uint8_t flags = 0;
+    size_t distance = 0;
+    size_t len;
+    int err;
+
+    _group_len = 1;
+    _group_pos = 0;
+    for (int i = 0; i < 8; i++) {
+        err = _fill();
+        if (err) {
+            return err;
+        }
+        if (_pos == _end) {
+            // end of data
+            break;
+        }
+        len = _find_match(distance);
+        if (len) {
+            size_t offset = distance - 1;
+            _group[_group_len++] = (uint8_t)(offset >> 4);
+            _group[_group_len++] = (uint8_t)(((offset & 0x0F) << 4) | (len - MIN_MATCH));
+        } else {
+            flags |= 1 << i;
+            _group[_group_len++] = _buf[_pos];
+            len = 1;
+        }
+        for (size_t j = 0; j < len; j++) {
+            _insert_hash(_pos);
+            _pos++;
+        }
+    }
+    if (_group_len == 1) {
+        // stream is finished
+        _group_len = 0;
+    }
+    _group[0] = flags;
+    return 0;
+}
+
+ssize_t LZSSEncoder::read(uint8_t *data, size_t size)
+{
+    size_t data_len = 0;
+    int err;
+
+    if (_source_error) {
+        return _source_error;
+    }
+    while (data_len < size) {
+        if (_group_pos == _group_len) {
+            err = _encode_group();
+            if (err) {
+                return err;
+            }
+            if (_group_len == 0) {
+                break;
+            }
+        }
+        size_t chunk_len = _group_len - _group_pos;
+        if (chunk_len > size - data_len) {
+            chunk_len = size - data_len;
+        }
+        memcpy(data + data_len, _group + _group_pos, chunk_len);
+        _group_pos += chunk_len;
+        data_len += chunk_len;
+    }
+    return data_len;
+}
+
+/**
+ * Decoder
+ */
+
+LZSSDecoder::LZSSDecoder()
+{
+    start(nullptr);
+}
+
+LZSSDecoder::~LZSSDecoder()
+{
+}
+
+void LZSSDecoder::start(Callback<ssize_t(uint8_t *, size_t)> sink)
+{
+    _sink = sink;
+    _decoded = 0;
+    _flushed = 0;
+    _flags = 0;
+    _items_left = 0;
+    _ref_byte = 0;
+    _has_ref_byte = false;
+}
+
+int LZSSDecoder::_flush()
+{
+    while (_flushed != _decoded) {
+        size_t index = _flushed & (WINDOW_SIZE - 1);
+        size_t len = _decoded - _flushed;
+        if (len > WINDOW_SIZE - index) {
+            len = WINDOW_SIZE - index;
+        }
+        ssize_t res = _sink(_window + index, len);
+        if (res < 0) {
+            return res;
+        } else if ((size_t)res > len) {
+            return MBED_ERROR_INVALID_SIZE;
+        }
+        _flushed += res;
+    }
+    return 0;
+}
+
+int LZSSDecoder::_put(uint8_t value)
+{
+    if (_decoded - _flushed == WINDOW_SIZE) {
+        // window is full, so pass data to user code before overwriting it
+        int err = _flush();
+        if (err) {
+            return err;
+        }
+    }
+    _window[_decoded & (WINDOW_SIZE - 1)] = value;
+    _decoded++;
+    return 0;
+}
+
+ssize_t LZSSDecoder::write(uint8_t *data, size_t size)
+{
+    int err;
+
+    for (size_t i = 0; i < size; i++) {
+        uint8_t value = data[i];
+        if (_items_left == 0) {
+            _flags = value;
+            _items_left = 8;
+        } else if (_flags & 0x01) {
+            err = _put(value);
+            if (err) {
+                return err;
+            }
+            _flags >>= 1;
+            _items_left--;
+        } else if (!_has_ref_byte) {
+            _ref_byte = value;
+            _has_ref_byte = true;
+        } else {
+            size_t distance = (((size_t)_ref_byte << 4) | (value >> 4)) + 1;
+            size_t len = (value & 0x0F) + MIN_MATCH;
+            if (distance > WINDOW_SIZE || distance > _decoded) {
+                return MBED_ERROR_INVALID_DATA_DETECTED;
+            }
+            for (size_t j = 0; j < len; j++) {
+                err = _put(_window[(_decoded - distance) & (WINDOW_SIZE - 1)]);
+                if (err) {
+                    return err;
+                }
+            }
+            _has_ref_byte = false;
+            _flags >>= 1;
+            _items_left--;
+        }
+    }
+
+    err = _flush();
+    return err ? err : (ssize_t)size;
+}
+
+int LZSSDecoder::finish()
+{
+    if (_has_ref_byte) {
+        return MBED_ERROR_INVALID_DATA_DETECTED;
+    }
+    return _flush();
+}
@@ -1,6 +1,7 @@
 #include "sim5320_LocationService.h"
 
 #include <chrono>
+#include <string.h>
 
 #include "sim5320_trace.h"
 #include "sim5320_utils.h"
@@ -15,9 +16,13 @@ void SIM5320LocationService::_cgpsftm_urc()
     const size_t data_buf_size = 8;
     char data_buf[data_buf_size];
     ssize_t res;
-    int total_sat = 0;
+    int prn;
+    int snr;
+    int best_snrs[4] = { 0, 0, 0, 0 };
+    gps_signal_info_t info;
 
-    _last_cgpsftm_urc_timestamp = to_ms_u32(_up_timer.elapsed_time());
+    memset(&info, 0, sizeof(info));
+    info.timestamp = to_ms_u32(_up_timer.elapsed_time());
 
     // skip first comma after "$GPGSV"
     _at.skip_param();
@@ -28,37 +33,89 @@ void SIM5320LocationService::_cgpsftm_urc()
         if (res < 0) {
             break;
         }
+        prn = atoi(data_buf);
         // read satellite sinal power
         res = _at.read_string(data_buf, data_buf_size);
         if (res < 0) {
             break;
         }
+        // note: empty value means that satellite isn't tracked
+        snr = atoi(data_buf);
         // satellite is found
-        total_sat++;
+        if (info.sats_in_view < GPS_MAX_SATELLITES) {
+            info.sats[info.sats_in_view].prn = prn;
+            info.sats[info.sats_in_view].snr = snr;
+        }
+        info.sats_in_view++;
+        if (snr >= GPS_GOOD_SNR) {
+            info.good_sats++;
+        }
+        if (snr > info.max_snr) {
+            info.max_snr = snr;
+        }
+        // update best SNR values
+        for (int i = 0; i < 4; i++) {
+            if (snr > best_snrs[i]) {
+                int tmp = best_snrs[i];
+                best_snrs[i] = snr;
+                snr = tmp;
+            }
+        }
     }
+    info.score = best_snrs[0] + best_snrs[1] + best_snrs[2] + best_snrs[3];
 
-    _last_cgpsftm_urc_sats = total_sat;
+    // note: report can be read from other threads
+    CriticalSectionLock lock;
+    _signal_info = info;
 }
 
-SIM5320LocationService::SIM5320LocationService(ATHandler &at)
+SIM5320LocationService::SIM5320LocationService(ATHandler &at, SIM5320SettingsCache *settings_cache)
     : _at(at)
+    , _settings_cache(settings_cache)
+    , _stream_seq(0)
+    , _stream_cb(nullptr)
+    , _async_ctx(nullptr)
+    , _async_generation(0)
+    , _async_orphan_steps(0)
+    , _gps_accuracy(_GPS_DEFAULT_ACCURACY)
 {
+    memset(&_stream_coord, 0, sizeof(_stream_coord));
+    memset(&_signal_info, 0, sizeof(_signal_info));
+    clear_last_location();
     _at.set_urc_handler("$GPGSV", callback(this, &SIM5320LocationService::_cgpsftm_urc));
+    _at.set_urc_handler("+CGPSINFO:", callback(this, &SIM5320LocationService::_cgpsinfo_urc));
 }
 
 SIM5320LocationService::~SIM5320LocationService()
 {
+    gps_locate_cancel();
+    // wait dispatched steps of the cancelled operation, as they still use this object
+    while (true) {
+        _async_mutex.lock();
+        int orphan_steps = _async_orphan_steps;
+        _async_mutex.unlock();
+        if (orphan_steps == 0) {
+            break;
+        }
+        ThisThread::sleep_for(1ms);
+    }
     _at.set_urc_handler("$GPGSV", nullptr);
+    _at.set_urc_handler("+CGPSINFO:", nullptr);
 }
 
 nsapi_error_t SIM5320LocationService::init()
 {
     ATHandlerLocker locker(_at);
 
-    // disable automatic (AT+CGPSAUTO) GPS start
-    at_cmdw_set_i(_at, "+CGPSAUTO", 0, false);
-    // set position mode (AT+CGPSPMD) to 127
-    at_cmdw_set_i(_at, "+CGPSPMD", 127, false);
+    if (_settings_cache) {
+        // disable automatic (AT+CGPSAUTO) GPS start
+        _settings_cache->write_i(_at, SIM5320SettingsCache::CGPSAUTO, "+CGPSAUTO", 0, false);
+        // set position mode (AT+CGPSPMD) to 127
+        _settings_cache->write_i(_at, SIM5320SettingsCache::CGPSPMD, "+CGPSPMD", 127, false);
+    } else {
+        at_cmdw_set_i(_at, "+CGPSAUTO", 0, false);
+        at_cmdw_set_i(_at, "+CGPSPMD", 127, false);
+    }
     // ensure that GPS debug mode is disabled
     _at.at_cmd_discard("+CGPSFTM", "=", "%d", 0);
 
@@ -71,6 +128,7 @@ nsapi_error_t SIM5320LocationService::init()
 constexpr milliseconds_u32 SIM5320LocationService::_GPS_START_TIMEOUT;
 constexpr milliseconds_u32 SIM5320LocationService::_GPS_STOP_TIMEOUT;
 constexpr milliseconds_u32 SIM5320LocationService::_GPS_SS_CHECK_PERIOD;
+constexpr std::chrono::seconds SIM5320LocationService::_GPS_STREAM_MAX_PERIOD;
 
 nsapi_error_t SIM5320LocationService::_wait_gps_start_stop(bool state, milliseconds_u32 timeout, milliseconds_u32 check_period)
 {
@@ -85,7 +143,8 @@ nsapi_error_t SIM5320LocationService::_wait_gps_start_stop(bool state, milliseco
 
     while (true) {
         elapsed_time = to_ms_u32(_up_timer.elapsed_time()) - start_time;
-        err = gps_is_active(active);
+        // note: GPS state is changing, so read it from device
+        err = gps_is_active(active, true);
         if (err) {
             return err;
         }
@@ -104,11 +163,16 @@ nsapi_error_t SIM5320LocationService::_wait_gps_start_stop(bool state, milliseco
     return _at.get_last_error();
 }
 
-nsapi_error_t SIM5320LocationService::gps_start(SIM5320LocationService::GPSMode mode, SIM5320LocationService::GPSStartupMode startup_mode)
+nsapi_error_t SIM5320LocationService::_gps_start_cmd(SIM5320LocationService::GPSMode mode, SIM5320LocationService::GPSStartupMode startup_mode)
 {
     ATHandlerLocker locker(_at);
     int err;
 
+    // GPS state is unknown till startup end
+    if (_settings_cache) {
+        _settings_cache->invalidate(SIM5320SettingsCache::CGPS);
+    }
+
     if (mode == GPS_MODE_STANDALONE) {
         if (startup_mode == GPS_STARTUP_MODE_AUTO) {
             err = at_cmdw_set_ii(_at, "+CGPS", 1, 1, false);
@@ -133,6 +197,16 @@ nsapi_error_t SIM5320LocationService::gps_start(SIM5320LocationService::GPSMode
     _up_timer.reset();
     _up_timer.start();
 
+    return NSAPI_ERROR_OK;
+}
+
+nsapi_error_t SIM5320LocationService::gps_start(SIM5320LocationService::GPSMode mode, SIM5320LocationService::GPSStartupMode startup_mode)
+{
+    ATHandlerLocker locker(_at);
+    int err = _gps_start_cmd(mode, startup_mode);
+    if (err) {
+        return err;
+    }
     return _wait_gps_start();
 }
 
@@ -152,83 +226,305 @@ static time_t fix_date_week_rollover(time_t t)
     return t;
 }
 
-nsapi_error_t SIM5320LocationService::gps_read_coord(SIM5320LocationService::coord_t *coord, bool &ff_flag)
+/**
+ * Parse decimal number "[-]<int>[.<frac>]" with integer operations.
+ *
+ * @param str number string
+ * @param frac_digits number of the fraction digits to keep. The other digits are truncated.
+ * @param int_part absolute value of the integer part
+ * @param frac_part fraction part that is scaled to @p frac_digits digits
+ * @param negative sign flag
+ * @return 0 on success, otherwise non-zero value
+ */
+static int parse_decimal(const char *str, int frac_digits, int &int_part, int &frac_part, bool &negative)
+{
+    int digit;
+    int kept_digits = 0;
+
+    negative = str[0] == '-';
+    if (negative) {
+        str++;
+    }
+    SimpleStringParser parser(str);
+    int_part = 0;
+    frac_part = 0;
+    parser.consume_int(&int_part);
+    if (!parser.is_finshed()) {
+        parser.consume_literal(".");
+        while (!parser.is_finshed() && !parser.get_error()) {
+            if (parser.consume_int(&digit, 1)) {
+                break;
+            }
+            if (kept_digits < frac_digits) {
+                frac_part = frac_part * 10 + digit;
+                kept_digits++;
+            }
+        }
+    }
+    // scale fraction part
+    for (; kept_digits < frac_digits; kept_digits++) {
+        frac_part *= 10;
+    }
+    return parser.get_error();
+}
+
+/**
+ * Convert NMEA "dddmm.mmmmmm" value into 1e-7 degrees.
+ */
+static int32_t parse_nmea_coord(const char *str, char dir)
+{
+    int int_part;
+    int frac_part;
+    bool negative;
+    parse_decimal(str, 6, int_part, frac_part, negative);
+    int32_t minutes_e6 = (int_part % 100) * 1000000 + frac_part;
+    int32_t value = (int_part / 100) * 10000000 + (minutes_e6 + 3) / 6;
+    return (dir == 'S' || dir == 'W') ? -value : value;
+}
+
+namespace sim5320 {
+/**
+ * Raw "+CGPSINFO: " fields.
+ */
+struct cgpsinfo_fields_t {
+    char lat[16];
+    char lat_dir[4];
+    char log[16];
+    char log_dir[4];
+    char date[8];
+    char utc_time[10];
+    char alt[10];
+    char speed[10];
+    char course[10];
+};
+}
+
+/**
+ * Convert "+CGPSINFO: " fields into coordinates.
+ */
+static void parse_cgpsinfo_fields(const cgpsinfo_fields_t &fields, SIM5320LocationService::coord_fixed_t *coord, bool &ff_flag)
+{
+    if (strlen(fields.lat) == 0) {
+        // no data
+        ff_flag = false;
+        return;
+    }
+    // has coordinates
+    ff_flag = true;
+    // parse coordinates
+    int alt_int;
+    int alt_frac;
+    bool alt_negative;
+    parse_decimal(fields.alt, 2, alt_int, alt_frac, alt_negative);
+    int32_t alt = alt_int * 100 + alt_frac;
+    // speed over ground in knots
+    int speed_int;
+    int speed_frac;
+    bool speed_negative;
+    parse_decimal(fields.speed, 3, speed_int, speed_frac, speed_negative);
+    int64_t speed_knots_e3 = (int64_t)speed_int * 1000 + speed_frac;
+    // course over ground in degrees
+    int course_int;
+    int course_frac;
+    bool course_negative;
+    parse_decimal(fields.course, 2, course_int, course_frac, course_negative);
+    // parse date
+    tm gps_tm;
+    SimpleStringParser date_parser(fields.date);
+    date_parser.consume_int(&gps_tm.tm_mday, 2);
+    date_parser.consume_int(&gps_tm.tm_mon, 2);
+    date_parser.consume_int(&gps_tm.tm_year, 2);
+    // parse time "hhmmss.s"
+    int time_int;
+    int time_ms;
+    bool time_negative;
+    parse_decimal(fields.utc_time, 3, time_int, time_ms, time_negative);
+    gps_tm.tm_hour = time_int / 10000;
+    gps_tm.tm_min = time_int / 100 % 100;
+    gps_tm.tm_sec = time_int % 100;
+    gps_tm.tm_year += 100; // tm_year since 1900
+    gps_tm.tm_mon -= 1;
+    // fill result
+    coord->latitude = parse_nmea_coord(fields.lat, fields.lat_dir[0]);
+    coord->longitude = parse_nmea_coord(fields.log, fields.log_dir[0]);
+    coord->altitude = alt_negative ? -alt : alt;
+    coord->time = mktime(&gps_tm);
+    // fix rollover week issue
+    coord->time = fix_date_week_rollover(coord->time);
+    coord->time_ms = time_ms;
+    // 1 knot = 1852 m/h
+    coord->speed = (int32_t)((speed_knots_e3 * 1852 + 18000) / 36000);
+    coord->course = course_int * 100 + course_frac;
+}
+
+void SIM5320LocationService::_read_cgpsinfo_params(SIM5320LocationService::coord_fixed_t *coord, bool &ff_flag)
+{
+    cgpsinfo_fields_t fields;
+
+    // read response
+    // example 1: 3113.343286,N,12121.234064,E,250311,072809.3,44.1,0.0,0
+    // example 1: ,,,,,,,,
+    _at.read_string(fields.lat, sizeof(fields.lat));
+    _at.read_string(fields.lat_dir, sizeof(fields.lat_dir));
+    _at.read_string(fields.log, sizeof(fields.log));
+    _at.read_string(fields.log_dir, sizeof(fields.log_dir));
+    _at.read_string(fields.date, sizeof(fields.date));
+    _at.read_string(fields.utc_time, sizeof(fields.utc_time));
+    _at.read_string(fields.alt, sizeof(fields.alt));
+    _at.read_string(fields.speed, sizeof(fields.speed));
+    _at.read_string(fields.course, sizeof(fields.course));
+
+    if (_at.get_last_error()) {
+        ff_flag = false;
+    } else {
+        parse_cgpsinfo_fields(fields, coord, ff_flag);
+    }
+}
+
+int SIM5320LocationService::parse_cgpsinfo(const char *info, SIM5320LocationService::coord_fixed_t *coord, bool &ff_flag)
 {
-    char lat_str[16];
-    char lat_dir_str[4];
-    char log_str[16];
-    char log_dir_str[4];
-    char date_str[8];
-    char utc_time_str[10];
-    char alt_str[10];
+    cgpsinfo_fields_t fields;
+    SimpleStringParser parser(info);
 
+    ff_flag = false;
+    parser.consume_string_until_sep(fields.lat, sizeof(fields.lat), ',');
+    parser.consume_literal(",");
+    parser.consume_string_until_sep(fields.lat_dir, sizeof(fields.lat_dir), ',');
+    parser.consume_literal(",");
+    parser.consume_string_until_sep(fields.log, sizeof(fields.log), ',');
+    parser.consume_literal(",");
+    parser.consume_string_until_sep(fields.log_dir, sizeof(fields.log_dir), ',');
+    parser.consume_literal(",");
+    parser.consume_string_until_sep(fields.date, sizeof(fields.date), ',');
+    parser.consume_literal(",");
+    parser.consume_string_until_sep(fields.utc_time, sizeof(fields.utc_time), ',');
+    parser.consume_literal(",");
+    parser.consume_string_until_sep(fields.alt, sizeof(fields.alt), ',');
+    parser.consume_literal(",");
+    parser.consume_string_until_sep(fields.speed, sizeof(fields.speed), ',');
+    parser.consume_literal(",");
+    parser.consume_string_until_sep(fields.course, sizeof(fields.course), ',');
+    if (parser.get_error()) {
+        return parser.get_error();
+    }
+    if (!parser.is_finshed()) {
+        return -1;
+    }
+    parse_cgpsinfo_fields(fields, coord, ff_flag);
+    return 0;
+}
+
+void SIM5320LocationService::convert_coord(const SIM5320LocationService::coord_fixed_t &fixed_coord, SIM5320LocationService::coord_t *coord)
+{
+    coord->latitude = fixed_coord.latitude / 1e7f;
+    coord->longitude = fixed_coord.longitude / 1e7f;
+    coord->altitude = fixed_coord.altitude / 100.0f;
+    coord->time = fixed_coord.time;
+    coord->time_ms = fixed_coord.time_ms;
+    coord->speed = fixed_coord.speed / 100.0f;
+    coord->course = fixed_coord.course / 100.0f;
+}
+
+nsapi_error_t SIM5320LocationService::gps_read_coord(SIM5320LocationService::coord_fixed_t *coord, bool &ff_flag)
+{
     ATHandlerLocker locker(_at);
 
     _at.cmd_start("AT+CGPSINFO");
     _at.cmd_stop();
     _at.resp_start("+CGPSINFO:");
-    // read response
-    // example 1: 3113.343286,N,12121.234064,E,250311,072809.3,44.1,0.0,0
-    // example 1: ,,,,,,,,
-    _at.read_string(lat_str, 16);
-    _at.read_string(lat_dir_str, 4);
-    _at.read_string(log_str, 16);
-    _at.read_string(log_dir_str, 4);
-    _at.read_string(date_str, 8);
-    _at.read_string(utc_time_str, 10);
-    _at.read_string(alt_str, 10);
-    // ignore speed and course
-    _at.skip_param(2);
+    _read_cgpsinfo_params(coord, ff_flag);
     _at.resp_start("AmpI/AmpQ:");
     _at.skip_param(2);
     _at.resp_stop();
 
-    if (strlen(lat_str) == 0) {
-        // no data
-        ff_flag = false;
-    } else {
-        // has coordinates
-        ff_flag = true;
-        // parse coordinates
-        float lat = strtof(lat_str, NULL);
-        lat /= 100;
-        lat = (int)lat + (lat - (int)lat) * (5.0f / 3.0f);
-        if (lat_dir_str[0] == 'S') {
-            lat = -lat;
-        }
-        float log = strtof(log_str, NULL);
-        log /= 100;
-        log = (int)log + (log - (int)log) * (5.0f / 3.0f);
-        if (log_dir_str[0] == 'W') {
-            log = -log;
-        }
-        float alt = strtof(alt_str, NULL);
-        // parse date
-        tm gps_tm;
-        SimpleStringParser date_parser(date_str);
-        date_parser.consume_int(&gps_tm.tm_mday, 2);
-        date_parser.consume_int(&gps_tm.tm_mon, 2);
-        date_parser.consume_int(&gps_tm.tm_year, 2);
-        int sub_sec;
-        SimpleStringParser time_parser(utc_time_str);
-        time_parser.consume_int(&gps_tm.tm_hour, 2);
-        time_parser.consume_int(&gps_tm.tm_min, 2);
-        time_parser.consume_int(&gps_tm.tm_sec, 2);
-        time_parser.consume_literal(".");
-        time_parser.consume_int(&sub_sec);
-        gps_tm.tm_year += 100; // tm_year since 1900
-        gps_tm.tm_mon -= 1;
-        // fill result
-        coord->latitude = lat;
-        coord->longitude = log;
-        coord->altitude = alt;
-        coord->time = mktime(&gps_tm);
-        // fix rollover week issue
-        coord->time = fix_date_week_rollover(coord->time);
+    nsapi_error_t err = _at.get_last_error();
+    if (!err && ff_flag) {
+        _update_last_location(*coord, LOCATION_SOURCE_GPS, _gps_accuracy);
     }
-    _at.resp_stop();
+    return err;
+}
 
-    return _at.get_last_error();
+nsapi_error_t SIM5320LocationService::gps_read_coord(SIM5320LocationService::coord_t *coord, bool &ff_flag)
+{
+    coord_fixed_t fixed_coord;
+    nsapi_error_t err = gps_read_coord(&fixed_coord, ff_flag);
+    if (!err && ff_flag) {
+        convert_coord(fixed_coord, coord);
+    }
+    return err;
+}
+
+void SIM5320LocationService::_cgpsinfo_urc()
+{
+    coord_fixed_t coord;
+    bool ff_flag = false;
+
+    _read_cgpsinfo_params(&coord, ff_flag);
+    if (!ff_flag) {
+        return;
+    }
+    _update_last_location(coord, LOCATION_SOURCE_GPS, _gps_accuracy);
+
+    // publish fix into the latest value slot
+    {
+        CriticalSectionLock lock;
+        _stream_coord = coord;
+        _stream_seq++;
+    }
+
+    if (_stream_cb) {
+        coord_t float_coord;
+        convert_coord(coord, &float_coord);
+        _stream_cb(float_coord);
+    }
+}
+
+nsapi_error_t SIM5320LocationService::gps_stream_start(std::chrono::seconds period, Callback<void(const coord_t &coord)> fix_cb)
+{
+    if (period < 1s || period > _GPS_STREAM_MAX_PERIOD) {
+        return NSAPI_ERROR_PARAMETER;
+    }
+    ATHandlerLocker locker(_at);
+    _stream_cb = fix_cb;
+    // enable periodic "+CGPSINFO: " URC codes
+    nsapi_error_t err = _at.at_cmd_discard("+CGPSINFO", "=", "%d", (int)period.count());
+    if (err) {
+        _stream_cb = nullptr;
+    }
+    return err;
+}
+
+nsapi_error_t SIM5320LocationService::gps_stream_stop()
+{
+    ATHandlerLocker locker(_at);
+    nsapi_error_t err = _at.at_cmd_discard("+CGPSINFO", "=", "%d", 0);
+    _stream_cb = nullptr;
+    return err;
+}
+
+bool SIM5320LocationService::gps_stream_read(SIM5320LocationService::coord_fixed_t *coord, uint32_t *fix_number)
+{
+    uint32_t seq;
+    {
+        CriticalSectionLock lock;
+        *coord = _stream_coord;
+        seq = _stream_seq;
+    }
+
+    if (fix_number) {
+        *fix_number = seq;
+    }
+    return seq != 0;
+}
+
+bool SIM5320LocationService::gps_stream_read(SIM5320LocationService::coord_t *coord, uint32_t *fix_number)
+{
+    coord_fixed_t fixed_coord;
+    bool res = gps_stream_read(&fixed_coord, fix_number);
+    if (res) {
+        convert_coord(fixed_coord, coord);
+    }
+    return res;
 }
 
 int SIM5320LocationService::_gps_stop_internal(milliseconds_u32 &op_duration)
@@ -237,6 +533,11 @@ int SIM5320LocationService::_gps_stop_internal(milliseconds_u32 &op_duration)
     int err;
     milliseconds_u32 op_start = to_ms_u32(_up_timer.elapsed_time());
 
+    // GPS state is unknown till stop end
+    if (_settings_cache) {
+        _settings_cache->invalidate(SIM5320SettingsCache::CGPS);
+    }
+
     if ((err = at_cmdw_set_i(_at, "+CGPS", 0, false))) {
         return err;
     }
@@ -257,25 +558,42 @@ nsapi_error_t SIM5320LocationService::gps_stop()
     return _gps_stop_internal(op_duration);
 }
 
-nsapi_error_t SIM5320LocationService::_gps_locate_base_impl(SIM5320LocationService::coord_t *coord, bool &ff_flag, SIM5320LocationService::GPSMode mode, SIM5320LocationService::GPSStartupMode startup_mode, Callback<milliseconds_u32(int)> timeout_cb, milliseconds_u32 poll_period)
+nsapi_error_t SIM5320LocationService::gps_set_signal_monitoring(bool enabled)
+{
+    ATHandlerLocker locker(_at);
+    if (enabled) {
+        CriticalSectionLock lock;
+        memset(&_signal_info, 0, sizeof(_signal_info));
+        _signal_info.timestamp = to_ms_u32(_up_timer.elapsed_time());
+    }
+    return _at.at_cmd_discard("+CGPSFTM", "=", "%d", enabled ? 1 : 0);
+}
+
+void SIM5320LocationService::gps_get_signal_info(SIM5320LocationService::gps_signal_info_t *info)
+{
+    CriticalSectionLock lock;
+    *info = _signal_info;
+}
+
+nsapi_error_t SIM5320LocationService::_gps_locate_base_impl(SIM5320LocationService::coord_t *coord, bool &ff_flag, SIM5320LocationService::GPSMode mode, SIM5320LocationService::GPSStartupMode startup_mode, Callback<bool(const gps_signal_info_t &, milliseconds_u32)> continue_cb, milliseconds_u32 poll_period)
 {
     int err = 0;
     milliseconds_u32 op_duration;
     milliseconds_u32 elapsed_time;
     milliseconds_u32 poll_elapsated;
     milliseconds_u32 op_start;
+    gps_signal_info_t signal_info;
 
     ATHandlerLocker lock(_at);
     ff_flag = false;
+    memset(&signal_info, 0, sizeof(signal_info));
 
     // run GPS, ignore current settings
     gps_start(mode, startup_mode);
 
     op_start = to_ms_u32(_up_timer.elapsed_time());
     // enable CGPSFTM URC codes
-    _last_cgpsftm_urc_sats = 0;
-    _last_cgpsftm_urc_timestamp = op_start;
-    _at.at_cmd_discard("+CGPSFTM", "=", "%d", 1);
+    gps_set_signal_monitoring(true);
 
     // wait first fix
     while (true) {
@@ -287,7 +605,8 @@ nsapi_error_t SIM5320LocationService::_gps_locate_base_impl(SIM5320LocationServi
         if (ff_flag) {
             break;
         }
-        if (elapsed_time > timeout_cb(_last_cgpsftm_urc_sats)) {
+        gps_get_signal_info(&signal_info);
+        if (!continue_cb(signal_info, elapsed_time)) {
             break;
         }
         // ensure that we process URC code every second
@@ -301,7 +620,7 @@ nsapi_error_t SIM5320LocationService::_gps_locate_base_impl(SIM5320LocationServi
     }
 
     // disable CGPSFTM URC codes
-    _at.at_cmd_discard("+CGPSFTM", "=", "%d", 0);
+    gps_set_signal_monitoring(false);
     // stop GPS
     _gps_stop_internal(op_duration);
 
@@ -309,7 +628,7 @@ nsapi_error_t SIM5320LocationService::_gps_locate_base_impl(SIM5320LocationServi
         // add stop operation compensation
         coord->time += op_duration.count() / 1000;
     } else {
-        tr_debug("Cannot resolve coordinates with %i satellites in view", _last_cgpsftm_urc_sats);
+        tr_debug("Cannot resolve coordinates with %i satellites in view (max SNR %i)", signal_info.sats_in_view, signal_info.max_snr);
     }
 
     return err;
@@ -320,16 +639,93 @@ nsapi_error_t SIM5320LocationService::_gps_locate_base_impl(SIM5320LocationServi
 // 2) open sky, weak signal: ~ 100 sec
 static constexpr milliseconds_u32 _GPS_POLL_PERIOD = 2s;
 static constexpr milliseconds_u32 _GPS_RETRY_PERIOD = 32s;
-// note: if at least one satellite is found, wait more
-static milliseconds_u32 calc_ttf_timeout(int total_sat_in_view)
-{
-    if (total_sat_in_view <= 0) {
-        return 32s;
-    } else if (total_sat_in_view <= 2) {
-        return 128s;
-    } else {
-        return 640s;
+
+namespace sim5320 {
+/**
+ * Helper model that decides if a fix can be got with current satellite signals.
+ *
+ * A fix requires at least 4 satellites with a signal that is strong enough to decode ephemeris,
+ * so the attempt is continued while signals are good or improving, and is aborted when they stall.
+ * Steady weak signals of 4 tracked satellites are still enough for a fix, but ephemeris decoding takes longer,
+ * so such attempts are continued up to the maximal time to first fix.
+ */
+struct ttff_model_t {
+    // maximal time to first fix
+    static constexpr milliseconds_u32 MAX_TTFF = 640s;
+    // time to find any satellite
+    static constexpr milliseconds_u32 NO_SATS_TIMEOUT = 32s;
+    // time to get any usable signal
+    static constexpr milliseconds_u32 WEAK_SIGNAL_TIMEOUT = 64s;
+    // maximal time without signal improvement
+    static constexpr milliseconds_u32 STALL_TIMEOUT = 96s;
+    // SNR that is required to track satellite
+    static const int MIN_USABLE_SNR = 20;
+    // number of the tracked satellites that is required for a fix
+    static const int MIN_FIX_SATS = 4;
+    // minimal score gain that is considered as signal improvement
+    static const int MIN_SCORE_GAIN = 8;
+
+    int best_score;
+    milliseconds_u32 best_score_time;
+
+    ttff_model_t()
+        : best_score(0)
+        , best_score_time(0)
+    {
     }
+
+    static int count_usable_sats(const SIM5320LocationService::gps_signal_info_t &info)
+    {
+        int sats_num = info.sats_in_view;
+        if (sats_num > SIM5320LocationService::GPS_MAX_SATELLITES) {
+            sats_num = SIM5320LocationService::GPS_MAX_SATELLITES;
+        }
+        int usable_sats = 0;
+        for (int i = 0; i < sats_num; i++) {
+            if (info.sats[i].snr >= MIN_USABLE_SNR) {
+                usable_sats++;
+            }
+        }
+        return usable_sats;
+    }
+
+    bool should_continue(const SIM5320LocationService::gps_signal_info_t &info, milliseconds_u32 elapsed_time)
+    {
+        if (info.score >= best_score + MIN_SCORE_GAIN) {
+            best_score = info.score;
+            best_score_time = elapsed_time;
+        }
+
+        if (elapsed_time > MAX_TTFF) {
+            return false;
+        }
+        if (info.sats_in_view == 0) {
+            return elapsed_time <= NO_SATS_TIMEOUT;
+        }
+        if (info.good_sats >= MIN_FIX_SATS) {
+            // fix is likely, so wait ephemeris
+            return true;
+        }
+        if (count_usable_sats(info) >= MIN_FIX_SATS) {
+            // signals are weak, but enough to decode ephemeris slowly
+            return true;
+        }
+        if (info.max_snr < MIN_USABLE_SNR && elapsed_time > WEAK_SIGNAL_TIMEOUT) {
+            tr_debug("GPS signal is too weak (max SNR %i)", info.max_snr);
+            return false;
+        }
+        if (elapsed_time - best_score_time > STALL_TIMEOUT) {
+            tr_debug("GPS signal doesn't improve (%i good satellites, score %i)", info.good_sats, info.score);
+            return false;
+        }
+        return true;
+    }
+};
+
+constexpr milliseconds_u32 ttff_model_t::MAX_TTFF;
+constexpr milliseconds_u32 ttff_model_t::NO_SATS_TIMEOUT;
+constexpr milliseconds_u32 ttff_model_t::WEAK_SIGNAL_TIMEOUT;
+constexpr milliseconds_u32 ttff_model_t::STALL_TIMEOUT;
 }
 
 nsapi_error_t SIM5320LocationService::gps_locate(SIM5320LocationService::coord_t *coord, bool &ff_flag, SIM5320LocationService::GPSMode mode)
@@ -341,7 +737,8 @@ nsapi_error_t SIM5320LocationService::gps_locate(SIM5320LocationService::coord_t
     ff_flag = false;
 
     // First attempt. Try to use existed GPS settings.
-    err = _gps_locate_base_impl(coord, ff_flag, mode, GPS_STARTUP_MODE_AUTO, callback(calc_ttf_timeout), _GPS_POLL_PERIOD);
+    ttff_model_t first_model;
+    err = _gps_locate_base_impl(coord, ff_flag, mode, GPS_STARTUP_MODE_AUTO, callback(&first_model, &ttff_model_t::should_continue), _GPS_POLL_PERIOD);
     if (!err && ff_flag) {
         return 0;
     }
@@ -359,7 +756,8 @@ nsapi_error_t SIM5320LocationService::gps_locate(SIM5320LocationService::coord_t
     ThisThread::sleep_for(_GPS_RETRY_PERIOD);
 
     // try to get gps coordinates again
-    err = _gps_locate_base_impl(coord, ff_flag, GPS_MODE_STANDALONE, GPS_STARTUP_MODE_COLD, callback(calc_ttf_timeout), _GPS_POLL_PERIOD);
+    ttff_model_t second_model;
+    err = _gps_locate_base_impl(coord, ff_flag, GPS_MODE_STANDALONE, GPS_STARTUP_MODE_COLD, callback(&second_model, &ttff_model_t::should_continue), _GPS_POLL_PERIOD);
     if (xtra_usage_flag) {
         // restore xtra function
         gps_xtra_set(true);
@@ -376,17 +774,288 @@ nsapi_error_t SIM5320LocationService::gps_locate(SIM5320LocationService::coord_t
     return err;
 }
 
-nsapi_error_t SIM5320LocationService::gps_is_active(bool &flag)
+namespace sim5320 {
+/**
+ * State of the asynchronous location resolving.
+ */
+struct gps_locate_async_ctx_t {
+    enum State {
+        STATE_START,
+        STATE_START_WAIT,
+        STATE_POLL,
+        STATE_STOP,
+        STATE_STOP_WAIT
+    };
+
+    EventQueue *queue;
+    int event_id;
+    // operation number that is passed to its events
+    uint32_t generation;
+    Callback<void(nsapi_error_t, const SIM5320LocationService::coord_t &)> done_cb;
+
+    State state;
+    int attempt;
+    SIM5320LocationService::GPSMode mode;
+    SIM5320LocationService::GPSStartupMode startup_mode;
+    bool restore_xtra;
+    ttff_model_t model;
+    // start time of the current state
+    milliseconds_u32 state_start;
+    // start time of the coordinates waiting
+    milliseconds_u32 op_start;
+
+    nsapi_error_t err;
+    bool ff_flag;
+    SIM5320LocationService::coord_t coord;
+};
+}
+
+void SIM5320LocationService::_gps_locate_async_step(uint32_t generation)
+{
+    nsapi_error_t err;
+    bool active;
+    bool finished = false;
+    milliseconds_u32 delay = 0ms;
+    milliseconds_u32 now;
+    Callback<void(nsapi_error_t, const coord_t &)> done_cb;
+    nsapi_error_t result_err;
+    coord_t result_coord;
+
+    // note: ATHandler is locked only during one step, so other AT commands can be used between them.
+    // The context is deleted by ::gps_locate_cancel only with ATHandler lock, so it can be used
+    // without _async_mutex till the step end.
+    _at.lock();
+    _async_mutex.lock();
+    gps_locate_async_ctx_t *ctx = _async_ctx;
+    if (ctx == nullptr || ctx->generation != generation) {
+        // operation has been cancelled
+        _async_orphan_steps--;
+        _async_mutex.unlock();
+        _at.unlock();
+        return;
+    }
+    ctx->event_id = 0;
+    _async_mutex.unlock();
+
+    now = to_ms_u32(_up_timer.elapsed_time());
+    switch (ctx->state) {
+        case gps_locate_async_ctx_t::STATE_START:
+            err = _gps_start_cmd(ctx->mode, ctx->startup_mode);
+            ctx->state_start = to_ms_u32(_up_timer.elapsed_time());
+            if (err) {
+                ctx->err = err;
+                ctx->state = gps_locate_async_ctx_t::STATE_STOP;
+            } else {
+                ctx->state = gps_locate_async_ctx_t::STATE_START_WAIT;
+                delay = _GPS_SS_CHECK_PERIOD;
+            }
+            break;
+        case gps_locate_async_ctx_t::STATE_START_WAIT:
+            err = gps_is_active(active, true);
+            if (!err && active) {
+                gps_set_signal_monitoring(true);
+                ctx->model = ttff_model_t();
+                ctx->op_start = now;
+                ctx->state = gps_locate_async_ctx_t::STATE_POLL;
+            } else if (err || now - ctx->state_start > _GPS_START_TIMEOUT) {
+                ctx->err = err ? err : NSAPI_ERROR_TIMEOUT;
+                ctx->state = gps_locate_async_ctx_t::STATE_STOP;
+            } else {
+                delay = _GPS_SS_CHECK_PERIOD;
+            }
+            break;
+        case gps_locate_async_ctx_t::STATE_POLL: {
+            gps_signal_info_t signal_info;
+            err = gps_read_coord(&ctx->coord, ctx->ff_flag);
+            gps_get_signal_info(&signal_info);
+            if (err) {
+                ctx->err = err;
+                ctx->state = gps_locate_async_ctx_t::STATE_STOP;
+            } else if (ctx->ff_flag || !ctx->model.should_continue(signal_info, now - ctx->op_start)) {
+                ctx->state = gps_locate_async_ctx_t::STATE_STOP;
+            } else {
+                delay = _GPS_POLL_PERIOD;
+            }
+            break;
+        }
+        case gps_locate_async_ctx_t::STATE_STOP:
+            gps_set_signal_monitoring(false);
+            // GPS state is unknown till stop end
+            if (_settings_cache) {
+                _settings_cache->invalidate(SIM5320SettingsCache::CGPS);
+            }
+            at_cmdw_set_i(_at, "+CGPS", 0, false);
+            _at.clear_error();
+            ctx->state_start = now;
+            ctx->state = gps_locate_async_ctx_t::STATE_STOP_WAIT;
+            delay = _GPS_SS_CHECK_PERIOD;
+            break;
+        case gps_locate_async_ctx_t::STATE_STOP_WAIT:
+            err = gps_is_active(active, true);
+            if (!err && active && now - ctx->state_start <= _GPS_STOP_TIMEOUT) {
+                delay = _GPS_SS_CHECK_PERIOD;
+                break;
+            }
+            _at.clear_error();
+            if (!err && !active) {
+                _up_timer.stop();
+            }
+            if (ctx->ff_flag) {
+                // add stop operation compensation
+                ctx->coord.time += (now - ctx->state_start).count() / 1000;
+                ctx->err = NSAPI_ERROR_OK;
+                finished = true;
+            } else if (ctx->attempt == 1) {
+                tr_error("First attempts of gps coordinates resolving has failed. Clear data and try again ...");
+                // Second attempt. Try to disable all GPS features and use cold start
+                bool xtra_usage_flag = false;
+                err = gps_xtra_get(xtra_usage_flag);
+                if (err || xtra_usage_flag) {
+                    gps_xtra_set(false);
+                }
+                ctx->restore_xtra = !err && xtra_usage_flag;
+                _at.clear_error();
+                ctx->attempt = 2;
+                ctx->err = NSAPI_ERROR_OK;
+                ctx->mode = GPS_MODE_STANDALONE;
+                ctx->startup_mode = GPS_STARTUP_MODE_COLD;
+                ctx->state = gps_locate_async_ctx_t::STATE_START;
+                delay = _GPS_RETRY_PERIOD;
+            } else {
+                if (!ctx->err) {
+                    ctx->err = NSAPI_ERROR_TIMEOUT;
+                }
+                finished = true;
+            }
+            break;
+    }
+
+    if (!finished) {
+        int event_id = ctx->queue->call_in(delay, this, &SIM5320LocationService::_gps_locate_async_step, generation);
+        _async_mutex.lock();
+        ctx->event_id = event_id;
+        _async_mutex.unlock();
+        if (event_id == 0) {
+            // event queue is full
+            tr_error("Cannot schedule gps location event");
+            ctx->err = NSAPI_ERROR_NO_MEMORY;
+            _gps_stop_internal(delay);
+            finished = true;
+        }
+    }
+    if (finished) {
+        if (ctx->restore_xtra) {
+            gps_xtra_set(true);
+        }
+        done_cb = ctx->done_cb;
+        result_err = ctx->err;
+        result_coord = ctx->coord;
+        _async_mutex.lock();
+        delete ctx;
+        _async_ctx = nullptr;
+        _async_mutex.unlock();
+    }
+    _at.unlock();
+
+    // note: invoke callback without locks, so it can start new operation
+    if (finished && done_cb) {
+        done_cb(result_err, result_coord);
+    }
+}
+
+nsapi_error_t SIM5320LocationService::gps_locate_async(EventQueue *queue, Callback<void(nsapi_error_t err, const coord_t &coord)> done_cb, SIM5320LocationService::GPSMode mode)
+{
+    if (queue == nullptr) {
+        return NSAPI_ERROR_PARAMETER;
+    }
+    ScopedLock<Mutex> lock(_async_mutex);
+    if (_async_ctx) {
+        return NSAPI_ERROR_BUSY;
+    }
+
+    gps_locate_async_ctx_t *ctx = new gps_locate_async_ctx_t();
+    memset(&ctx->coord, 0, sizeof(ctx->coord));
+    ctx->queue = queue;
+    ctx->done_cb = done_cb;
+    ctx->state = gps_locate_async_ctx_t::STATE_START;
+    ctx->attempt = 1;
+    ctx->mode = mode;
+    ctx->startup_mode = GPS_STARTUP_MODE_AUTO;
+    ctx->restore_xtra = false;
+    ctx->state_start = 0ms;
+    ctx->op_start = 0ms;
+    ctx->err = NSAPI_ERROR_OK;
+    ctx->ff_flag = false;
+    ctx->generation = ++_async_generation;
+    ctx->event_id = queue->call(this, &SIM5320LocationService::_gps_locate_async_step, ctx->generation);
+    if (ctx->event_id == 0) {
+        delete ctx;
+        return NSAPI_ERROR_NO_MEMORY;
+    }
+    _async_ctx = ctx;
+    return NSAPI_ERROR_OK;
+}
+
+nsapi_error_t SIM5320LocationService::gps_locate_cancel()
+{
+    bool active = false;
+    bool restore_xtra;
+    nsapi_error_t err;
+    // note: lock ATHandler before _async_mutex to avoid context deletion during a step (see ::_gps_locate_async_step)
+    ATHandlerLocker locker(_at);
+
+    _async_mutex.lock();
+    if (_async_ctx == nullptr) {
+        _async_mutex.unlock();
+        return NSAPI_ERROR_OK;
+    }
+    if (_async_ctx->event_id && !_async_ctx->queue->cancel(_async_ctx->event_id)) {
+        // event has been dispatched and waits ATHandler lock, it will be ignored as its context is deleted
+        _async_orphan_steps++;
+    }
+    restore_xtra = _async_ctx->restore_xtra;
+    delete _async_ctx;
+    _async_ctx = nullptr;
+    _async_mutex.unlock();
+
+    // stop GPS if it has been started
+    gps_set_signal_monitoring(false);
+    err = gps_is_active(active, true);
+    if (!err && active) {
+        err = gps_stop();
+    }
+    if (restore_xtra) {
+        gps_xtra_set(true);
+    }
+    return err;
+}
+
+bool SIM5320LocationService::gps_locate_is_running()
+{
+    ScopedLock<Mutex> lock(_async_mutex);
+    return _async_ctx != nullptr;
+}
+
+nsapi_error_t SIM5320LocationService::gps_is_active(bool &flag, bool force_refresh)
 {
     int state_flag;
     int mode_flag;
+    uint32_t cached_state_flag;
     int err;
 
+    if (!force_refresh && _settings_cache && _settings_cache->get(SIM5320SettingsCache::CGPS, cached_state_flag)) {
+        flag = cached_state_flag;
+        return NSAPI_ERROR_OK;
+    }
+
     if ((err = at_cmdw_get_ii(_at, "+CGPS", state_flag, mode_flag))) {
         return err;
     }
 
     flag = state_flag;
+    if (_settings_cache) {
+        _settings_cache->set(SIM5320SettingsCache::CGPS, state_flag);
+    }
 
     return err;
 }
@@ -398,12 +1067,20 @@ nsapi_error_t SIM5320LocationService::gps_clear_data()
 
 nsapi_error_t SIM5320LocationService::gps_set_accuracy(int value)
 {
-    return at_cmdw_set_i(_at, "+CGPSHOR", value);
+    nsapi_error_t err = at_cmdw_set_i(_at, "+CGPSHOR", value);
+    if (!err) {
+        _gps_accuracy = value;
+    }
+    return err;
 }
 
 nsapi_error_t SIM5320LocationService::gps_get_accuracy(int &value)
 {
-    return at_cmdw_get_i(_at, "+CGPSHOR", value);
+    nsapi_error_t err = at_cmdw_get_i(_at, "+CGPSHOR", value);
+    if (!err) {
+        _gps_accuracy = value;
+    }
+    return err;
 }
 
 nsapi_error_t SIM5320LocationService::gps_set_agps_server(const char *server, bool ssl)
@@ -557,3 +1234,54 @@ nsapi_error_t SIM5320LocationService::cell_system_read_info(SIM5320LocationServi
 
     return err;
 }
+
+void SIM5320LocationService::_update_last_location(const coord_fixed_t &coord, LocationSource source, int accuracy)
+{
+    Kernel::Clock::time_point now = Kernel::Clock::now();
+    // note: location can be read from other threads
+    CriticalSectionLock lock;
+    _last_location.coord = coord;
+    _last_location.source = source;
+    _last_location.accuracy = accuracy;
+    _last_location.timestamp = now;
+}
+
+bool SIM5320LocationService::get_last_location(location_t *location, milliseconds_u32 max_age)
+{
+    Kernel::Clock::time_point now = Kernel::Clock::now();
+    {
+        CriticalSectionLock lock;
+        *location = _last_location;
+    }
+    return location->source != LOCATION_SOURCE_NONE && now - location->timestamp <= max_age;
+}
+
+bool SIM5320LocationService::get_last_location(coord_t *coord, milliseconds_u32 max_age)
+{
+    location_t location;
+    bool res = get_last_location(&location, max_age);
+    if (res) {
+        convert_coord(location.coord, coord);
+    }
+    return res;
+}
+
+void SIM5320LocationService::set_last_location(const coord_fixed_t &coord, LocationSource source, int accuracy, milliseconds_u32 max_gps_age)
+{
+    location_t last_location;
+    if (source != LOCATION_SOURCE_GPS && get_last_location(&last_location, max_gps_age)
+            && last_location.source == LOCATION_SOURCE_GPS && last_location.accuracy <= accuracy) {
+        // keep more accurate GPS fix
+        return;
+    }
+    _update_last_location(coord, source, accuracy);
+}
+
+void SIM5320LocationService::clear_last_location()
+{
+    CriticalSectionLock lock;
+    memset(&_last_location.coord, 0, sizeof(_last_location.coord));
+    _last_location.source = LOCATION_SOURCE_NONE;
+    _last_location.accuracy = 0;
+    _last_location.timestamp = Kernel::Clock::time_point();
+}
@@ -0,0 +1,212 @@
+#include "sim5320_SettingsCache.h"
+
+#include <string.h>
+
+#include "sim5320_trace.h"
+#include "sim5320_utils.h"
+
+using namespace sim5320;
+
+/**
+ * Setting description.
+ */
+struct setting_desc_t {
+    /** command name without "AT" prefix */
+    const char *cmd;
+    /** flag that value can be read with "AT<cmd>?" command and compared with cached value */
+    bool verifiable;
+};
+
+static const setting_desc_t SETTING_DESCS[SIM5320SettingsCache::SETTING_MAX] = {
+    { "+CGDCONT", false },
+    { "+CSOCKSETPN", true },
+    { "+CNMP", true },
+    { "+CIPSRIP", true },
+    { "+CIPMODE", true },
+    { "+CIPRXGET", true },
+    { "+CIPCCFG", false },
+    { "+CTZU", true },
+    { "+CGPSAUTO", true },
+    { "+CGPSPMD", true },
+    { "+CHTPSERV", false },
+    { "+CFUN", true },
+    { "+CGATT", true },
+    { "+CGPS", true },
+};
+
+SIM5320SettingsCache::SIM5320SettingsCache()
+    : _valid_mask(0)
+    , _write_count(0)
+    , _enabled(true)
+{
+    MBED_STATIC_ASSERT(SETTING_MAX <= 32, "Settings mask is too small");
+    memset(_values, 0, sizeof(_values));
+}
+
+SIM5320SettingsCache::~SIM5320SettingsCache()
+{
+}
+
+void SIM5320SettingsCache::set_enabled(bool enabled)
+{
+    _enabled = enabled;
+    if (!enabled) {
+        invalidate();
+    }
+}
+
+bool SIM5320SettingsCache::is_set(SIM5320SettingsCache::Setting setting, uint32_t value) const
+{
+    uint32_t cached_value;
+    return get(setting, cached_value) && cached_value == value;
+}
+
+bool SIM5320SettingsCache::get(SIM5320SettingsCache::Setting setting, uint32_t &value) const
+{
+    if (!_enabled) {
+        return false;
+    }
+    // note: states can be updated from URC handlers, so protect value and mask consistency
+    CriticalSectionLock lock;
+    if (!(_valid_mask & (1u << setting))) {
+        return false;
+    }
+    value = _values[setting];
+    return true;
+}
+
+void SIM5320SettingsCache::set(SIM5320SettingsCache::Setting setting, uint32_t value)
+{
+    if (!_enabled) {
+        return;
+    }
+    CriticalSectionLock lock;
+    _values[setting] = value;
+    _valid_mask |= 1u << setting;
+    if (!(STATES_MASK & (1u << setting))) {
+        _write_count++;
+    }
+}
+
+void SIM5320SettingsCache::invalidate(SIM5320SettingsCache::Setting setting)
+{
+    CriticalSectionLock lock;
+    _valid_mask &= ~(1u << setting);
+}
+
+void SIM5320SettingsCache::invalidate()
+{
+    CriticalSectionLock lock;
+    _valid_mask = 0;
+}
+
+void SIM5320SettingsCache::invalidate_states()
+{
+    CriticalSectionLock lock;
+    _valid_mask &= ~STATES_MASK;
+}
+
+void SIM5320SettingsCache::update_power_level(int func_level)
+{
+    if (!is_set(CFUN, func_level)) {
+        // network attach and GPS states depend on power level, but settings are kept by device
+        invalidate_states();
+        set(CFUN, func_level);
+    }
+}
+
+uint32_t SIM5320SettingsCache::get_write_count() const
+{
+    return _write_count;
+}
+
+nsapi_error_t SIM5320SettingsCache::write_i(ATHandler &at, SIM5320SettingsCache::Setting setting, const char *cmd, int value, bool lock)
+{
+    nsapi_error_t err;
+    if (is_set(setting, value)) {
+        return lock ? NSAPI_ERROR_OK : at.get_last_error();
+    }
+    err = at_cmdw_set_i(at, cmd, value, lock);
+    if (!err) {
+        set(setting, value);
+    }
+    return err;
+}
+
+// max command length: "AT" + "+CSOCKSETPN?;" * SETTING_MAX
+#define VERIFY_CMD_MAX_LEN 200
+#define VERIFY_PREFIX_MAX_LEN 16
+
+nsapi_error_t SIM5320SettingsCache::verify(ATHandler &at)
+{
+    char cmd_buf[VERIFY_CMD_MAX_LEN];
+    char prefix_buf[VERIFY_PREFIX_MAX_LEN];
+    size_t cmd_len = 2;
+    uint32_t verify_mask = 0;
+    int value;
+    nsapi_error_t err;
+
+    // build compound command like "AT+CNMP?;+CIPMODE?"
+    strcpy(cmd_buf, "AT");
+    for (int i = 0; i < SETTING_MAX; i++) {
+        if (!(_valid_mask & (1u << i)) || !SETTING_DESCS[i].verifiable) {
+            continue;
+        }
+        if (verify_mask) {
+            cmd_buf[cmd_len++] = ';';
+        }
+        strcpy(cmd_buf + cmd_len, SETTING_DESCS[i].cmd);
+        cmd_len += strlen(SETTING_DESCS[i].cmd);
+        cmd_buf[cmd_len++] = '?';
+        cmd_buf[cmd_len] = '\0';
+        verify_mask |= 1u << i;
+    }
+    if (!verify_mask) {
+        return NSAPI_ERROR_OK;
+    }
+
+    at.lock();
+    at.cmd_start(cmd_buf);
+    at.cmd_stop();
+    // responses have the same order as commands
+    for (int i = 0; i < SETTING_MAX; i++) {
+        if (!(verify_mask & (1u << i))) {
+            continue;
+        }
+        strcpy(prefix_buf, SETTING_DESCS[i].cmd);
+        strcat(prefix_buf, ":");
+        at.resp_start(prefix_buf);
+        value = at.read_int();
+        if (at.get_last_error()) {
+            break;
+        }
+        if ((uint32_t)value != _values[i]) {
+            tr_debug("settings cache: %s value %d differs from cached one", SETTING_DESCS[i].cmd, value);
+            invalidate((Setting)i);
+        }
+    }
+    at.resp_stop();
+    err = at.unlock_return_error();
+
+    if (err) {
+        // settings cannot be validated, so rewrite them
+        invalidate();
+    }
+    return err;
+}
+
+uint32_t SIM5320SettingsCache::hash(const char *str, uint32_t hash)
+{
+    // FNV-1a hash
+    if (str == nullptr) {
+        str = "";
+    }
+    while (*str != '\0') {
+        hash ^= (uint8_t)*str;
+        hash *= 16777619u;
+        str++;
+    }
+    // add terminator to distinguish lists of strings ("ab", "c") and ("a", "bc")
+    hash *= 16777619u;
+    return hash;
+}
@@ -8,8 +8,9 @@
 
 using namespace sim5320;
 
-SIM5320TimeService::SIM5320TimeService(ATHandler &at)
+SIM5320TimeService::SIM5320TimeService(ATHandler &at, SIM5320SettingsCache *settings_cache)
     : _at(at)
+    , _settings_cache(settings_cache)
     , _htp_servers(nullptr)
     , _htp_servers_num(0)
 {
@@ -19,22 +20,11 @@ SIM5320TimeService::~SIM5320TimeService()
 {
 }
 
-nsapi_error_t SIM5320TimeService::_sync_time_with_htp_servers(const char *const servers[], size_t size)
+nsapi_error_t SIM5320TimeService::_write_htp_servers(const char *const servers[], size_t size)
 {
-    // note: we explicitly set a list of http server before each update, as after device resetting it loses them.
-    int err;
-    int res;
-    int code;
     const size_t hostname_size = 64;
     char hostname[hostname_size];
     int port;
-    int n;
-
-    if (_htp_servers == nullptr) {
-        return -1;
-    }
-
-    ATHandlerLocker locker(_at);
 
     // delete old existed domains
     while (!_at.get_last_error()) {
@@ -62,8 +52,37 @@ nsapi_error_t SIM5320TimeService::_sync_time_with_htp_servers(const char *const
         _at.at_cmd_discard("+CHTPSERV", "=", "%s%s%d%d", "ADD", hostname, port, i);
     }
 
-    if ((err = _at.get_last_error())) {
-        return err;
+    return _at.get_last_error();
+}
+
+nsapi_error_t SIM5320TimeService::_sync_time_with_htp_servers(const char *const servers[], size_t size)
+{
+    // note: we explicitly set a list of http server before each update, as after device resetting it loses them.
+    //       The settings cache is invalidated after reset, so list is rewritten only if it's needed.
+    int err;
+    int res;
+    int code;
+    uint32_t servers_hash = SIM5320SettingsCache::HASH_INIT;
+
+    if (_htp_servers == nullptr) {
+        return -1;
+    }
+
+    ATHandlerLocker locker(_at);
+
+    for (size_t i = 0; i < size; i++) {
+        servers_hash = SIM5320SettingsCache::hash(servers[i], servers_hash);
+    }
+    if (!_settings_cache || !_settings_cache->is_set(SIM5320SettingsCache::CHTPSERV, servers_hash)) {
+        if (_settings_cache) {
+            _settings_cache->invalidate(SIM5320SettingsCache::CHTPSERV);
+        }
+        if ((err = _write_htp_servers(servers, size))) {
+            return err;
+        }
+        if (_settings_cache) {
+            _settings_cache->set(SIM5320SettingsCache::CHTPSERV, servers_hash);
+        }
     }
 
     // try to synchronize time with http
@@ -143,6 +162,9 @@ nsapi_error_t SIM5320TimeService::_read_modem_clk(time_t *time)
 
 nsapi_error_t SIM5320TimeService::set_tzu(bool state)
 {
+    if (_settings_cache) {
+        return _settings_cache->write_i(_at, SIM5320SettingsCache::CTZU, "+CTZU", state ? 1 : 0);
+    }
     return at_cmdw_set_b(_at, "+CTZU", state);
 }
 
@@ -7,6 +7,8 @@
 using mbed::chrono::milliseconds_u32;
 using namespace sim5320;
 
+#define to_ms_u32(value) std::chrono::duration_cast<milliseconds_u32>(value)
+
 static const int SIM5320_SERIAL_BAUDRATE = 115200;
 
 SIM5320::SIM5320(BufferedSerial *serial_ptr, PinName rts, PinName cts, PinName rst)
@@ -56,11 +58,18 @@ void SIM5320::_init_driver()
 
     _startup_request_count = 0;
     _network_up_request_count = 0;
+    _fast_boot = false;
     _at = _device->get_at_handler();
+
+    _urc_dispatcher_queue = nullptr;
+    _urc_dispatcher_own_queue = nullptr;
+    _urc_dispatcher_thread = nullptr;
 }
 
 SIM5320::~SIM5320()
 {
+    stop_urc_dispatcher();
+
     _device->close_information();
     _device->close_network();
 #if MBED_CONF_CELLULAR_USE_SMS
@@ -145,6 +154,8 @@ nsapi_error_t SIM5320::init()
 
 nsapi_error_t SIM5320::set_factory_settings()
 {
+    // all settings will be restored to default values
+    _device->get_settings_cache()->invalidate();
     ATHandlerLocker locker(*_at);
     _at->cmd_start("AT&F");
     _at->cmd_stop_read_resp();
@@ -247,6 +258,61 @@ nsapi_error_t SIM5320::process_urc()
     return NSAPI_ERROR_OK;
 }
 
+// the dispatcher queue holds only chained device queue events and initial OOB processing event
+static constexpr size_t URC_DISPATCHER_QUEUE_SIZE = 4 * EVENTS_EVENT_SIZE;
+
+nsapi_error_t SIM5320::start_urc_dispatcher(EventQueue *queue)
+{
+    if (_urc_dispatcher_queue) {
+        return NSAPI_ERROR_ALREADY;
+    }
+
+    if (queue == nullptr) {
+        // run own dispatcher thread
+        _urc_dispatcher_own_queue = new EventQueue(URC_DISPATCHER_QUEUE_SIZE);
+        _urc_dispatcher_thread = new Thread(osPriorityNormal, MBED_CONF_SIM5320_DRIVER_URC_DISPATCHER_STACK_SIZE, nullptr, "sim5320_urc");
+        if (_urc_dispatcher_thread->start(callback(_urc_dispatcher_own_queue, &EventQueue::dispatch_forever)) != osOK) {
+            delete _urc_dispatcher_thread;
+            delete _urc_dispatcher_own_queue;
+            _urc_dispatcher_thread = nullptr;
+            _urc_dispatcher_own_queue = nullptr;
+            return NSAPI_ERROR_NO_MEMORY;
+        }
+        queue = _urc_dispatcher_own_queue;
+    }
+    _urc_dispatcher_queue = queue;
+
+    // ATHandler posts OOB processing into device queue on serial sigio event,
+    // so forward device queue events to the dispatcher queue
+    _device->get_queue()->chain(_urc_dispatcher_queue);
+    // process data that could be received before dispatcher startup
+    _urc_dispatcher_queue->call(callback(_at, &ATHandler::process_oob));
+    tr_debug("sim5320: URC dispatcher is started");
+
+    return NSAPI_ERROR_OK;
+}
+
+nsapi_error_t SIM5320::stop_urc_dispatcher()
+{
+    if (!_urc_dispatcher_queue) {
+        return NSAPI_ERROR_OK;
+    }
+
+    _device->get_queue()->chain(nullptr);
+    if (_urc_dispatcher_thread) {
+        _urc_dispatcher_own_queue->break_dispatch();
+        _urc_dispatcher_thread->join();
+        delete _urc_dispatcher_thread;
+        delete _urc_dispatcher_own_queue;
+        _urc_dispatcher_thread = nullptr;
+        _urc_dispatcher_own_queue = nullptr;
+    }
+    _urc_dispatcher_queue = nullptr;
+    tr_debug("sim5320: URC dispatcher is stopped");
+
+    return NSAPI_ERROR_OK;
+}
+
 nsapi_error_t SIM5320::reset(SIM5320::ResetMode reset_mode)
 {
     int err;
@@ -269,6 +335,8 @@ nsapi_error_t SIM5320::reset(SIM5320::ResetMode reset_mode)
         err = _reset_hard();
         break;
     }
+    // device settings are lost after reset
+    _device->get_settings_cache()->invalidate();
     if (err) {
         return err;
     }
@@ -286,11 +354,16 @@ nsapi_error_t SIM5320::reset(SIM5320::ResetMode reset_mode)
     return NSAPI_ERROR_OK;
 }
 
-nsapi_error_t SIM5320::is_active(bool &active)
+void SIM5320::set_fast_boot(bool enabled)
+{
+    _fast_boot = enabled;
+}
+
+nsapi_error_t SIM5320::is_active(bool &active, bool force_refresh)
 {
     int err;
     int func_level;
-    if ((err = _device->get_power_level(func_level))) {
+    if ((err = _device->get_power_level(func_level, force_refresh))) {
         return err;
     }
 
@@ -340,7 +413,13 @@ SIM5320TimeService *SIM5320::get_time_service()
     return _time_service;
 }
 
+SIM5320SettingsCache *SIM5320::get_settings_cache()
+{
+    return _device->get_settings_cache();
+}
+
 constexpr milliseconds_u32 SIM5320::_STARTUP_TIMEOUT;
+constexpr milliseconds_u32 SIM5320::_FAST_BOOT_POLL_PERIOD;
 
 nsapi_error_t SIM5320::_reset_soft()
 {
@@ -382,12 +461,55 @@ nsapi_error_t SIM5320::_skip_initialization_messages()
     int res;
 
     ATHandlerLocker locker(*_at, _STARTUP_TIMEOUT);
+    // note: device can answer AT commands for some time after reset command, so wait "START" message in any mode
     _at->resp_start("START", true);
     res = _at->get_last_error();
+
+    if (_fast_boot) {
+        // don't wait phonebook, it will be tracked by device
+        _at->clear_error();
+        _device->set_phonebook_ready(false);
+        locker.unlock();
+        if (res) {
+            // "START" message has been missed, but device has certainly rebooted after timeout, so check AT interface
+            tr_warning("sim5320: \"START\" message isn't received. Check AT interface");
+            res = _wait_at_interface();
+        }
+        return res;
+    }
+
     // if there is not error, wait PB DONE
     _at->resp_start("PB DONE", true);
     // clear any error codes of this step
     _at->clear_error();
+    _device->set_phonebook_ready(true);
+
+    return res;
+}
+
+nsapi_error_t SIM5320::_wait_at_interface()
+{
+    int res;
+    Timer timer;
+    timer.start();
+
+    while (true) {
+        {
+            ATHandlerLocker locker(*_at, _FAST_BOOT_POLL_PERIOD);
+            // note: device echo can be enabled, but it will be skipped by ATHandler
+            _at->cmd_start("AT");
+            _at->cmd_stop_read_resp();
+            res = _at->get_last_error();
+        }
+        if (!res) {
+            tr_debug("sim5320: AT interface is ready after %i ms", (int)to_ms_u32(timer.elapsed_time()).count());
+            break;
+        }
+        if (timer.elapsed_time() > _STARTUP_TIMEOUT) {
+            break;
+        }
+        ThisThread::sleep_for(_FAST_BOOT_POLL_PERIOD);
+    }
 
     return res;
 }
@@ -3,6 +3,7 @@
 #include "sim5320_utils.h"
 
 #include <limits.h>
+#include <stdlib.h>
 #include <string.h>
 
 using namespace sim5320;
@@ -101,25 +102,44 @@ int sim5320::vread_full_fuzzy_response(ATHandler &at, bool wait_response_after_o
 ATHandlerLocker::ATHandlerLocker(ATHandler &at, mbed::chrono::milliseconds_u32 timeout)
     : _at(at)
     , _timeout(timeout)
+    , _lock_count(0)
 {
-    _at.lock();
-    if (timeout > 0ms) {
-        _at.set_at_timeout(timeout);
-    }
+    lock();
 }
 
 sim5320::ATHandlerLocker::~ATHandlerLocker()
 {
+    unlock();
+}
+
+void sim5320::ATHandlerLocker::reset_timeout()
+{
+    _at.lock();
+    _at.unlock();
+}
+
+void sim5320::ATHandlerLocker::unlock()
+{
+    if (_lock_count <= 0) {
+        return;
+    }
     if (_timeout > 0ms) {
         _at.restore_at_timeout();
     }
     _at.unlock();
+    _lock_count--;
 }
 
-void sim5320::ATHandlerLocker::reset_timeout()
+void sim5320::ATHandlerLocker::lock()
 {
+    if (_lock_count > 0) {
+        return;
+    }
     _at.lock();
-    _at.unlock();
+    if (_timeout > 0ms) {
+        _at.set_at_timeout(_timeout);
+    }
+    _lock_count++;
 }
 
 /**
@@ -270,6 +290,48 @@ nsapi_error_t sim5320::at_cmdw_get_ii(ATHandler &at, const char *cmd, int &value
     return at_cmdw_unlock_return_error(at, lock);
 }
 
+ssize_t sim5320::at_read_modem_file_block(ATHandler &at, const char *modem_path, long offset, uint8_t *buf, size_t size, bool lock)
+{
+    char param[8];
+    ssize_t data_len;
+    size_t block_len = 0;
+    int code = 0;
+    bool invalid_data = false;
+    nsapi_error_t err;
+
+    at_cmdw_lock(at, lock);
+    // response format:
+    //   +CFTRANTX: DATA,<len>
+    //   <data>
+    //   +CFTRANTX: 0
+    //   OK
+    at.cmd_start_stop("+CFTRANTX", "=", "%s%d%d", modem_path, (int)offset, (int)size);
+    at.resp_start("+CFTRANTX:");
+    while (at.info_resp()) {
+        at.read_string(param, sizeof(param));
+        if (strcmp(param, "DATA") != 0) {
+            code = atoi(param);
+            continue;
+        }
+        data_len = at.read_int();
+        if (data_len < 0 || (size_t)data_len > size - block_len || at.read_bytes(buf + block_len, data_len) != data_len) {
+            invalid_data = true;
+            break;
+        }
+        block_len += data_len;
+    }
+    at.resp_stop();
+    err = at_cmdw_unlock_return_error(at, lock);
+
+    if (err) {
+        return err;
+    }
+    if (invalid_data || code > 0) {
+        return NSAPI_ERROR_DEVICE_ERROR;
+    }
+    return block_len;
+}
+
 SimpleStringParser::SimpleStringParser(const char *str)
     : _str(str)
     , _err(0)
@@ -294,11 +356,11 @@ int SimpleStringParser::consume_int(int *result, int limit)
 
     // check sign
     if (*pos == '+' || *pos == '-') {
-        pos++;
-        limit--;
         if (*pos == '-') {
             neg_sign = true;
         }
+        pos++;
+        limit--;
     }
     // process number
     while (*pos >= '0' && *pos <= '9' && limit > 0) {